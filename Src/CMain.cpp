@@ -25,32 +25,48 @@
 
 #include <random>
 #include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <cstring>
 
 #include "CMain.h"
 #include "WindowsHelpers.h"
 #include "Perlin.h"
 #include "Defines.h"
 #include "Helpers.h"
+#include "Golden.h"
+#include "Fuzz.h"
+#include "RenderCache.h"
+#include "TileCache.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 // Constructors and destructors
 
 #pragma region Constructors and destructors
 
-/// Initialize GDI+, create the menus, and create the Perlin noise generator.
+/// Initialize GDI+, create the menus, create the Perlin noise generator,
+/// open the render cache, and create the tile cache.
 /// \param hwnd Window handle.
 
 CMain::CMain(const HWND hwnd): m_hWnd(hwnd){
   m_gdiplusToken = InitGDIPlus(); //initialize GDI+
   m_pPerlin = new CPerlinNoise2D(); //Perlin noise generator
+  m_pCache = new CRenderCache(GetCacheFolder(), m_nCacheBudget); //render cache
+  m_pTiles = new CTileCache(m_nCacheTileSize, m_nTileBudget); //tile cache
   CreateMenus(); //create the menu bar
 } //constructor
 
-/// Delete the Perlin noise generator, delete the GDI+ objects, shut down GDI+.
+/// Delete the Perlin noise generator and the caches, delete the GDI+
+/// objects, shut down GDI+.
 
 CMain::~CMain(){
   delete m_pPerlin; //delete the Perlin noise generator
+  delete m_pCache; //delete the render cache
+  delete m_pTiles; //delete the tile cache
   delete m_pBitmap; //delete the bitmap
+  delete [] m_fNoise; //delete the noise values
   Gdiplus::GdiplusShutdown(m_gdiplusToken); //shut down GDI+
 } //destructor
 
@@ -69,6 +85,16 @@ void CMain::OnPaint(){
   HDC hdc = BeginPaint(m_hWnd, &ps); //device context
   Gdiplus::Graphics graphics(hdc); //GDI+ graphics object
 
+  graphics.DrawImage(m_pBitmap, GetDestRect()); //draw image
+
+  EndPaint(m_hWnd, &ps); //this must be done last
+} //OnPaint
+
+/// Get the rectangle in the window client area that the bitmap is drawn to.
+/// The bitmap is centered and scaled down if necessary.
+/// \return The destination rectangle for the bitmap.
+
+const Gdiplus::Rect CMain::GetDestRect() const{
   //get bitmap width and height
   
   const int nBitmapWidth = m_pBitmap->GetWidth(); 
@@ -91,14 +117,8 @@ void CMain::OnPaint(){
   const int x = max(0, nClientWidth  - width)/2; //x margin
   const int y = max(0, nClientHeight - height)/2; //y margin
 
-  Gdiplus::Rect rectDest(x, y, width, height); //destination rectangle
-
-  //draw image to destination rectangle then clean up
-  
-  graphics.DrawImage(m_pBitmap, rectDest);
-
-  EndPaint(m_hWnd, &ps); //this must be done last
-} //OnPaint
+  return Gdiplus::Rect(x, y, width, height);
+} //GetDestRect
 
 #pragma endregion Drawing functions
 
@@ -118,6 +138,8 @@ void CMain::CreateMenus(){
   m_hDistMenu = CreateDistributionMenu(hMenubar);
   m_hHashMenu = CreateHashMenu(hMenubar);
   m_hSplineMenu = CreateSplineMenu(hMenubar);
+  m_hWorleyMenu = CreateWorleyMenu(hMenubar);
+  m_hFractalMenu = CreateFractalMenu(hMenubar);
   m_hSetMenu = CreateSettingsMenu(hMenubar);
   CreateHelpMenu(hMenubar);
 
@@ -130,17 +152,19 @@ void CMain::CreateMenus(){
 
 void CMain::UpdateMenus(){
   UpdateFileMenu(m_hFileMenu, m_eNoise); 
-  UpdateGenerateMenu(m_hGenMenu, m_eNoise);
+  UpdateGenerateMenu(m_hGenMenu, m_eNoise, CanSearchSeeds());
   UpdateViewMenu(m_hViewMenu, m_eNoise);
   UpdateDistributionMenu(m_hDistMenu, m_eNoise, m_pPerlin->GetDistribution()); 
   UpdateHashMenu(m_hHashMenu, m_eNoise, m_pPerlin->GetHash()); 
   UpdateSplineMenu(m_hSplineMenu, m_eNoise, m_pPerlin->GetSpline()); 
+  UpdateWorleyMenu(m_hWorleyMenu, m_eNoise, m_pPerlin->GetWorley()); 
+  UpdateFractalMenu(m_hFractalMenu, m_eNoise, m_pPerlin->GetFractal()); 
   UpdateSettingsMenu(m_hSetMenu, m_eNoise); 
 
   //update individual menu items
 
   UpdateMenuItemGray(m_hGenMenu, IDM_GENERATE_RESETORIGIN, m_eNoise,
-    m_fOriginX == 0.0f && m_fOriginY == 0.0f);
+    m_dOriginX == 0.0 && m_dOriginY == 0.0);
 
   UpdateMenuItem(m_hSetMenu, 
     IDM_SETTINGS_OCTAVE_UP, IDM_SETTINGS_OCTAVE_DN, m_eNoise, 
@@ -168,13 +192,16 @@ void CMain::UpdateMenus(){
 
 #pragma region Bitmap functions
 
-/// Create bitmap and set all pixels to white.
+/// Create bitmap and set all pixels to white. Create a matching array of
+/// noise values.
 /// \param w Bitmap width in pixels.
 /// \param h Bitmap height in pixels.
 
 void CMain::CreateBitmap(int w, int h){
   delete m_pBitmap; //safety
+  delete [] m_fNoise; //safety
   m_pBitmap = new Gdiplus::Bitmap(w, h); //create bitmap
+  m_fNoise = new float[w*h](); //create noise values
   ClearBitmap(Gdiplus::Color::White); //clear bitmap to white
 } //CreateBitmap
 
@@ -225,66 +252,284 @@ void CMain::SetPixel(UINT i, UINT j, Gdiplus::Color clr){
 
 #pragma region Noise generation functions
 
-/// Generate Perlin or Value noise into the bitmap. Pixel coordinates (which 
-/// are whole numbers) are offset by `m_fOriginX` and `m_fOriginY` and scaled
-/// by `m_fScale` to get noise coordinates (which are floating point numbers).
+/// Generate Perlin, Value, Simplex, or Worley noise into `m_fNoise` and draw
+/// it to the bitmap. Pixel coordinates (which are whole numbers) are scaled by
+/// `m_fScale` and offset by `m_dOriginX` and `m_dOriginY` to get noise
+/// coordinates (which are double precision floating point numbers so that
+/// the origin can be very far away). The work is shared out among one
+/// thread per hardware thread, unless the render cache or the tile cache
+/// already has it. There is no fixed-point Simplex or Worley noise, so
+/// fixed-point arithmetic is turned off for them.
 /// \param t Type of noise.
 
 void CMain::GenerateNoiseBitmap(eNoise t){ 
+  if(t != m_eNoise)Invalidate(); //different noise
   m_eNoise = t; //remember the noise type
+
+  if((t == eNoise::Simplex || t == eNoise::Worley) && m_bFixedPoint){
+    m_bFixedPoint = false; //not supported
+    UpdateMenuItemCheck(m_hSetMenu, IDM_SETTINGS_FIXED, m_bFixedPoint);
+    Invalidate(); //different noise
+  } //if
+
   UpdateMenus(); //changing noise type may change the menu status
+  GenerateNoise(true, true);
+} //GenerateNoiseBitmap
 
-  m_fMin = 1000.0f; //init noise minima to something stupidly large
-  m_fMax = -1000.0f; //init noise maxima to something stupidly small
-  m_fAve = 0.0f; //init sum for average
+/// Generate noise for the whole bitmap into `m_fNoise` and draw it to the
+/// bitmap. If the tile cache is to be used and it has every tile, then the
+/// noise is copied from it. Otherwise, if the render cache is to be used,
+/// then look the noise up in the render cache and if it is there, put its
+/// tiles into the tile cache, or else generate it and put it into the
+/// render cache. If the tile cache is to be used, then the noise is
+/// generated by `RenderTiles()`, which only renders the tiles that aren't
+/// in the tile cache, and otherwise by `RenderNoise()`. Statistics are
+/// gathered afterwards if the noise wasn't rendered by `RenderNoise()`,
+/// which gives the same statistics.
+/// \param bCache true to use the render cache.
+/// \param bTiles true to use the tile cache.
+
+void CMain::GenerateNoise(bool bCache, bool bTiles){
+  const size_t n = (size_t)m_pBitmap->GetWidth()*m_pBitmap->GetHeight();
+  const UINT nThreads = max(1U, std::thread::hardware_concurrency());
+
+  if(bTiles && HasTiles(true)){ //tile cache hit
+    RenderTiles(m_fNoise, nThreads);
+    GatherStats(m_fNoise, m_cStats);
+    DrawNoise();
+    return;
+  } //if
+
+  const std::wstring wstrKey = bCache? GetCacheKey(): L""; //cache key
+
+  if(bCache && m_pCache->Get(wstrKey, m_fNoise, n)){ //render cache hit
+    GatherStats(m_fNoise, m_cStats);
+    if(bTiles)PutTiles(m_fNoise);
+  } //if
 
+  else{ //cache miss or no cache
+    if(bTiles){
+      RenderTiles(m_fNoise, nThreads);
+      GatherStats(m_fNoise, m_cStats);
+    } //if
+
+    else RenderNoise(m_fNoise, nThreads, m_cStats);
+
+    if(bCache)m_pCache->Put(wstrKey, m_fNoise, n);
+  } //else
+
+  DrawNoise();
+} //GenerateNoise
+
+/// Generate noise for the whole bitmap into an array using a given number of
+/// threads and gather its statistics. The bitmap is cut into tiles of
+/// `m_nTileRows` rows, and the tiles are dealt out to the threads in turn
+/// so that each thread gets a similar share of the work even if the noise
+/// is more expensive in some parts of the image than in others. Each tile
+/// has its own statistics, which are reduced by `CNoiseStats::Reduce()` in a
+/// fixed order after all of the threads have finished. Since the tiles and
+/// the order do not depend on the threads, neither do the statistics, which
+/// come out bit-for-bit the same for any number of threads. Each tile is
+/// written by exactly one thread, so no locks are needed.
+/// \param pNoise [OUT] Array of noise values, one per pixel, row-major.
+/// \param n Number of threads.
+/// \param stats [OUT] Statistics of the noise values.
+
+void CMain::RenderNoise(float* pNoise, UINT n, CNoiseStats& stats) const{
+  const UINT h = m_pBitmap->GetHeight(); //bitmap height
+  std::vector<CNoiseStats> tile((h + m_nTileRows - 1)/m_nTileRows); //per tile
+  std::vector<std::thread> thread; //worker threads
+
+  for(UINT i=0; i<n; i++)
+    thread.push_back(std::thread(&CMain::GetNoiseTiles, this, pNoise, i, n,
+      tile.data()));
+
+  for(std::thread& th: thread)
+    th.join();
+
+  stats.Reduce(tile);
+} //RenderNoise
+
+/// Get the noise values for every \f$n\f$-th tile of `m_nTileRows` rows of
+/// pixels starting at a given tile. The noise generator's functions are all
+/// `const`, so any number of threads can call them at once. The statistics
+/// of each row are gathered while it is still in cache.
+/// \param pNoise [OUT] Array of noise values, one per pixel, row-major.
+/// \param first First tile.
+/// \param n Distance between tiles.
+/// \param pStats [OUT] Array of statistics, one per tile.
+
+void CMain::GetNoiseTiles(float* pNoise, UINT first, UINT n,
+  CNoiseStats* pStats) const
+{
+  const UINT w = m_pBitmap->GetWidth(); //bitmap width
+  const UINT h = m_pBitmap->GetHeight(); //bitmap height
+
+  for(UINT k=first; k*m_nTileRows<h; k+=n){ //for each of this thread's tiles
+    const UINT nBottom = min(h, (k + 1)*m_nTileRows); //row after last
+
+    for(UINT j=k*m_nTileRows; j<nBottom; j++){
+      const double y = m_dOriginY + j/(double)m_fScale; //noise Y-coordinate
+      GetNoiseRow(m_dOriginX, y, w, &pNoise[j*w]); //noise
+      pStats[k].Add(&pNoise[j*w], w); //statistics
+    } //for
+  } //for
+} //GetNoiseTiles
+
+/// Gather the statistics of noise that has already been generated, using the
+/// same tiles as `RenderNoise()` so that the results are the same.
+/// \param pNoise Array of noise values, one per pixel, row-major.
+/// \param stats [OUT] Statistics of the noise values.
+
+void CMain::GatherStats(const float* pNoise, CNoiseStats& stats) const{
   const UINT w = m_pBitmap->GetWidth(); //bitmap width
   const UINT h = m_pBitmap->GetHeight(); //bitmap height
+  std::vector<CNoiseStats> tile((h + m_nTileRows - 1)/m_nTileRows); //per tile
 
-  for(UINT i=0; i<w; i++){
-    const float x = m_fOriginX + i/m_fScale; //noise X-coordinate
+  for(UINT j=0; j<h; j++)
+    tile[j/m_nTileRows].Add(&pNoise[j*w], w);
 
-    for(UINT j=0; j<h; j++){
-      const float y = m_fOriginY + j/m_fScale; //noise Y-coordinate
-      const float noise = m_pPerlin->generate(x, y, t, m_nOctaves); //noise
-      SetPixel(i, j, noise); //draw noise pixel to bitmap
+  stats.Reduce(tile);
+} //GatherStats
 
-      //recompute maximum, minimum, and average
-      m_fMin = min(m_fMin, noise);
-      m_fMax = max(m_fMax, noise);
-      m_fAve += noise;
+/// Draw the noise values in `m_fNoise` to the bitmap and draw the grid and
+/// coordinates on top if required. The bitmap is locked and written to
+/// directly rather than with `SetPixel()`, which is far too slow for
+/// animation.
+
+void CMain::DrawNoise(){ 
+  const UINT w = m_pBitmap->GetWidth(); //bitmap width
+  const UINT h = m_pBitmap->GetHeight(); //bitmap height
+
+  Gdiplus::Rect rect(0, 0, (INT)w, (INT)h); //whole bitmap
+  Gdiplus::BitmapData data; //for locked pixels
+  m_pBitmap->LockBits(&rect, Gdiplus::ImageLockModeWrite,
+    PixelFormat32bppARGB, &data);
+
+  for(UINT j=0; j<h; j++){
+    UINT32* pRow = (UINT32*)((BYTE*)data.Scan0 + j*data.Stride); //pixel row
+
+    for(UINT i=0; i<w; i++){
+      const float noise = m_fNoise[j*w + i]; //noise
+      const UINT32 b = BYTE(float(0xFF)*(noise/2 + 0.5f)); //as in SetPixel()
+      pRow[i] = 0xFF000000 | (b << 16) | (b << 8) | b; //opaque gray
     } //for
   } //for
 
-  m_fAve /= w*h; //compute average from sum
+  m_pBitmap->UnlockBits(&data);
   
   if(m_bShowGrid)DrawGrid();
   if(m_bShowCoords)DrawCoords();
-} //GenerateNoiseBitmap
+} //DrawNoise
 
-/// Generate Perlin or Value noise into a rectangle in the bitmap. This is the
-/// cool thing about Perlin noise - the noise value at each point is computed
-/// independently of all the other points. We will use this to quickly
-/// remove the grid and/or the coordinate text from the bitmap without
-/// having to recompute noise values for the whole bitmap.
+/// Redraw the noise in a rectangle in the bitmap from the noise values saved
+/// in `m_fNoise`. We will use this to quickly remove the grid and/or the
+/// coordinate text from the bitmap without having to recompute any
+/// noise values.
 /// \param point The position of the rectangle to be written in the bitmap.
 /// \param rect The bounds of the rectangle to be written in the bitmap. 
 
 void CMain::GenerateNoiseBitmap(Gdiplus::PointF point, Gdiplus::RectF rect){
+  const UINT w = m_pBitmap->GetWidth(); //bitmap width
+  const UINT h = m_pBitmap->GetHeight(); //bitmap height
+
   const UINT nLeft   = (UINT)floorf(rect.GetLeft()  + point.X);
-  const UINT nRight  = (UINT)ceilf(rect.GetRight()  + point.X);
+  const UINT nRight  = min(w, (UINT)ceilf(rect.GetRight()  + point.X));
   const UINT nTop    = (UINT)floorf(rect.GetTop()   + point.Y);
-  const UINT nBottom = (UINT)ceilf(rect.GetBottom() + point.Y);
+  const UINT nBottom = min(h, (UINT)ceilf(rect.GetBottom() + point.Y));
+
+  for(UINT i=nLeft; i<nRight; i++)
+    for(UINT j=nTop; j<nBottom; j++)
+      SetPixel(i, j, m_fNoise[j*w + i]);
+} //GenerateNoiseBitmap
+
+/// Get the noise value at a point using the current noise type and number of
+/// octaves. If `m_bFixedPoint` is `true`, then the point is rounded to
+/// Q16 fixed point and the noise is computed using integer arithmetic only,
+/// otherwise it is computed using floating point arithmetic. In the latter
+/// case, if `m_bCullOctaves` is `true`, then octaves too fine to be
+/// represented at one sample per pixel are left out, and otherwise if
+/// `m_bDomainWarp` is `true`, then the noise is domain warped.
+/// \param x X-coordinate of point.
+/// \param y Y-coordinate of point.
+/// \return Noise value in \f$[-1, 1]\f$.
+
+const float CMain::GetNoise(double x, double y) const{
+  if(m_bFixedPoint){
+    const int64_t nX = (int64_t)llround(x*65536.0); //x in Q16
+    const int64_t nY = (int64_t)llround(y*65536.0); //y in Q16
+    return m_pPerlin->generatefixed(nX, nY, m_eNoise, m_nOctaves)/32768.0f;
+  } //if
+
+  if(m_bCullOctaves)
+    return m_pPerlin->generate(x, y, 1.0f/m_fScale, m_eNoise, m_nOctaves);
+
+  if(m_bDomainWarp){
+    float result = 0.0f; //for noise value
+    m_pPerlin->generatewarp(&x, &y, 1, &result, m_eNoise, m_nOctaves,
+      m_nWarpOctaves, m_nWarpLevels, m_fWarpStrength);
+    return result;
+  } //if
 
-  for(UINT i=nLeft; i<nRight; i++){
-    const float x = m_fOriginX + i/m_fScale;
+  return m_pPerlin->generate(x, y, m_eNoise, m_nOctaves);
+} //GetNoise
+
+/// Get the noise values for a row of pixels. If neither `m_bFixedPoint`
+/// nor `m_bCullOctaves` is `true`, then the row is handed to
+/// `GetNoisePoints()` a chunk at a time. Otherwise `GetNoise()` is called
+/// for each pixel. The coordinates are built on the stack so that nothing
+/// is allocated per row.
+/// \param x X-coordinate of the first pixel in the row.
+/// \param y Y-coordinate of the row.
+/// \param w Number of pixels in the row.
+/// \param result [OUT] Array of `w` noise values.
+
+void CMain::GetNoiseRow(double x, double y, UINT w, float* result) const{
+  if(m_bFixedPoint || m_bCullOctaves){ //no batch version
+    for(UINT i=0; i<w; i++)
+      result[i] = GetNoise(x + i/(double)m_fScale, y);
+    return;
+  } //if
+
+  const UINT nChunk = 256; //pixels per chunk
+
+  double pX[nChunk], pY[nChunk]; //coordinates
 
-    for(UINT j=nTop; j<nBottom; j++){
-      const float y = m_fOriginY + j/m_fScale;
-      SetPixel(i, j, m_pPerlin->generate(x, y, m_eNoise, m_nOctaves));
+  for(UINT i0=0; i0<w; i0+=nChunk){ //for each chunk
+    const UINT m = std::min<UINT>(nChunk, w - i0); //pixels in this chunk
+
+    for(UINT i=0; i<m; i++){
+      pX[i] = x + (i0 + i)/(double)m_fScale;
+      pY[i] = y;
     } //for
+
+    GetNoisePoints(pX, pY, m, &result[i0]);
   } //for
-} //GenerateNoiseBitmap
+} //GetNoiseRow
+
+/// Get the noise values at a batch of points. If neither `m_bFixedPoint`
+/// nor `m_bCullOctaves` is `true`, then the points are handed to the noise
+/// generator's batch function, or its domain warp function if
+/// `m_bDomainWarp` is `true`, which use SIMD instructions if they can.
+/// Otherwise `GetNoise()` is called for each point.
+/// \param pX Array of X-coordinates.
+/// \param pY Array of Y-coordinates.
+/// \param n Number of points.
+/// \param result [OUT] Array of `n` noise values.
+
+void CMain::GetNoisePoints(const double* pX, const double* pY, UINT n,
+  float* result) const
+{
+  if(m_bFixedPoint || m_bCullOctaves) //no batch version
+    for(UINT i=0; i<n; i++)
+      result[i] = GetNoise(pX[i], pY[i]);
+
+  else if(m_bDomainWarp)
+    m_pPerlin->generatewarp(pX, pY, n, result, m_eNoise, m_nOctaves,
+      m_nWarpOctaves, m_nWarpLevels, m_fWarpStrength);
+
+  else m_pPerlin->generatebatch(pX, pY, n, result, m_eNoise, m_nOctaves);
+} //GetNoisePoints
  
 /// If `m_bShowCoords` is `true`, then draw the coordinates of the top left
 /// and bottom right of the noise to the corresponding corners of the bitmap.
@@ -306,8 +551,8 @@ void CMain::DrawCoords(){
   Gdiplus::PointF point(0.0f, 0.0f); //text position on screen
   
   std::wstring wstr = L"("; //text of origin coordinates
-  wstr += std::to_wstring((size_t)floorf(m_fOriginX)) + L", ";
-  wstr += std::to_wstring((size_t)floorf(m_fOriginY)) + L")";
+  wstr += std::to_wstring((long long)floor(m_dOriginX)) + L", ";
+  wstr += std::to_wstring((long long)floor(m_dOriginY)) + L")";
   
   Gdiplus::RectF rect, unused;
   graphics.MeasureString(wstr.c_str(), -1, &font, unused, &rect); //measure text
@@ -318,8 +563,8 @@ void CMain::DrawCoords(){
 
   //bottom right corner coordinates
 
-  const float x = m_fOriginX + m_pBitmap->GetWidth()/m_fScale; //x-coordinate
-  const float y = m_fOriginY + m_pBitmap->GetHeight()/m_fScale; //y-coordinate
+  const double x = m_dOriginX + m_pBitmap->GetWidth()/m_fScale; //x-coordinate
+  const double y = m_dOriginY + m_pBitmap->GetHeight()/m_fScale; //y-coordinate
 
   wstr = L"(" + to_wstring_f(x, 2) + L", " + to_wstring_f(y, 2) + L")"; //text
 
@@ -394,18 +639,231 @@ void CMain::GenerateNoiseBitmap(){
 
 #pragma endregion Noise generation functions
 
+///////////////////////////////////////////////////////////////////////////////
+// Tile cache functions
+
+#pragma region Tile cache functions
+
+/// Invalidate the tile cache. This must be called whenever anything that
+/// changes the noise values changes, other than the origin and the scale,
+/// which are part of the tile keys. The tiles could never be found again
+/// since the parameter version in their keys is out of date, so their memory
+/// is freed right away.
+
+void CMain::Invalidate(){
+  m_nVersion++;
+  m_pTiles->Clear();
+} //Invalidate
+
+/// Get the keys of the tiles that overlap the bitmap, row by row. The pixel
+/// grid is the grid of points whose coordinates times `m_fScale` differ from
+/// those of the origin by whole numbers. Since the scale is a power of 2,
+/// the noise coordinates of each pixel are exactly the same whether they
+/// are computed from the origin or from a tile, and so are the noise values.
+/// \param key [OUT] Array of tile keys.
+/// \param nLeft [OUT] Pixel grid X-coordinate of the left column of the bitmap.
+/// \param nTop [OUT] Pixel grid Y-coordinate of the top row of the bitmap.
+
+void CMain::GetViewTiles(std::vector<TileKey>& key, int64_t& nLeft,
+  int64_t& nTop) const
+{
+  const int64_t n = (int64_t)m_pTiles->GetTileSize(); //tile size
+  const double dX = m_dOriginX*m_fScale; //origin X-coordinate in pixels
+  const double dY = m_dOriginY*m_fScale; //origin Y-coordinate in pixels
+
+  nLeft = (int64_t)floor(dX);
+  nTop  = (int64_t)floor(dY);
+
+  const int64_t nRight  = nLeft + m_pBitmap->GetWidth()  - 1; //last column
+  const int64_t nBottom = nTop  + m_pBitmap->GetHeight() - 1; //last row
+
+  auto tile = [n](int64_t i){ //tile containing pixel i, rounding down
+    return (i >= 0)? i/n: -((n - 1 - i)/n);
+  }; //tile
+
+  TileKey k; //tile key
+  k.dPhaseX  = dX - nLeft;
+  k.dPhaseY  = dY - nTop;
+  k.fScale   = m_fScale;
+  k.nVersion = m_nVersion;
+
+  key.clear();
+
+  for(k.nY=tile(nTop); k.nY<=tile(nBottom); k.nY++)
+    for(k.nX=tile(nLeft); k.nX<=tile(nRight); k.nX++)
+      key.push_back(k);
+} //GetViewTiles
+
+/// Check whether all or any of the tiles that overlap the bitmap are in the
+/// tile cache.
+/// \param bAll true to check for all tiles, false to check for any tile.
+/// \return true if all (respectively, any) of the tiles are in the tile cache.
+
+const bool CMain::HasTiles(bool bAll) const{
+  std::vector<TileKey> key; //tile keys
+  int64_t nLeft = 0, nTop = 0; //bitmap position in pixel grid
+
+  GetViewTiles(key, nLeft, nTop);
+
+  for(const TileKey& k: key)
+    if(m_pTiles->Has(k) != bAll)return !bAll;
+
+  return bAll;
+} //HasTiles
+
+/// Generate noise for the whole bitmap from tiles. Tiles that are in the tile
+/// cache are copied from it, and the others are rendered using a given
+/// number of threads, dealt out to them in turn as in `RenderNoise()`, then
+/// copied and put into the tile cache. Tiles are copied before anything is
+/// put into the cache so that none of them can be overwritten first.
+/// \param pNoise [OUT] Array of noise values, one per pixel, row-major.
+/// \param n Number of threads.
+
+void CMain::RenderTiles(float* pNoise, UINT n){
+  std::vector<TileKey> key; //tile keys
+  std::vector<TileKey> miss; //keys of tiles not in the tile cache
+  int64_t nLeft = 0, nTop = 0; //bitmap position in pixel grid
+
+  GetViewTiles(key, nLeft, nTop);
+
+  for(const TileKey& k: key){
+    const float* pTile = m_pTiles->Get(k); //tile, if cached
+    if(pTile)CopyTile(k, pTile, nLeft, nTop, pNoise); //hit
+    else miss.push_back(k); //miss
+  } //for
+
+  if(miss.empty())return; //nothing to render
+
+  const size_t nSize = m_nCacheTileSize*m_nCacheTileSize; //pixels per tile
+  float* pTiles = new float[miss.size()*nSize]; //rendered tiles
+  std::vector<std::thread> thread; //worker threads
+
+  n = (UINT)std::min<size_t>(n, miss.size()); //no idle threads
+
+  for(UINT i=0; i<n; i++)
+    thread.push_back(std::thread(&CMain::GetCacheTiles, this, std::cref(miss),
+      pTiles, i, n));
+
+  for(std::thread& th: thread)
+    th.join();
+
+  for(size_t i=0; i<miss.size(); i++)
+    CopyTile(miss[i], &pTiles[i*nSize], nLeft, nTop, pNoise);
+
+  for(size_t i=0; i<miss.size(); i++)
+    m_pTiles->Put(miss[i], &pTiles[i*nSize]);
+
+  delete [] pTiles;
+} //RenderTiles
+
+/// Put the tiles that lie entirely inside the bitmap into the tile cache,
+/// unless they are already there. This is used to remember noise that was
+/// generated without using tiles.
+/// \param pNoise Array of noise values, one per pixel, row-major.
+
+void CMain::PutTiles(const float* pNoise){
+  std::vector<TileKey> key; //tile keys
+  int64_t nLeft = 0, nTop = 0; //bitmap position in pixel grid
+
+  GetViewTiles(key, nLeft, nTop);
+
+  const int64_t n = (int64_t)m_nCacheTileSize; //tile size
+  const int64_t w = (int64_t)m_pBitmap->GetWidth(); //bitmap width
+  const int64_t h = (int64_t)m_pBitmap->GetHeight(); //bitmap height
+  float* pTile = new float[n*n]; //one tile
+
+  for(const TileKey& k: key){
+    const int64_t x = k.nX*n - nLeft; //bitmap column of left of tile
+    const int64_t y = k.nY*n - nTop; //bitmap row of top of tile
+
+    if(x >= 0 && y >= 0 && x + n <= w && y + n <= h && !m_pTiles->Has(k)){
+      for(int64_t j=0; j<n; j++)
+        memcpy(&pTile[j*n], &pNoise[(y + j)*w + x], n*sizeof(float));
+
+      m_pTiles->Put(k, pTile);
+    } //if
+  } //for
+
+  delete [] pTile;
+} //PutTiles
+
+/// Render the noise values for a tile.
+/// \param k Tile key.
+/// \param pNoise [OUT] Array of noise values for the tile, row-major.
+
+void CMain::GetCacheTile(const TileKey& k, float* pNoise) const{
+  const size_t n = m_nCacheTileSize; //tile size
+  const double x = (k.nX*(double)n + k.dPhaseX)/m_fScale; //left of tile
+
+  for(size_t j=0; j<n; j++){
+    const double y = (k.nY*(double)n + k.dPhaseY + j)/m_fScale; //row
+    GetNoiseRow(x, y, (UINT)n, &pNoise[j*n]);
+  } //for
+} //GetCacheTile
+
+/// Render every \f$n\f$-th tile in an array of tiles starting at a given
+/// tile. Each tile is written by exactly one thread, so no locks are needed.
+/// \param key Array of tile keys.
+/// \param pNoise [OUT] Array of noise values for the tiles, one tile after
+/// the other.
+/// \param first First tile.
+/// \param n Distance between tiles.
+
+void CMain::GetCacheTiles(const std::vector<TileKey>& key, float* pNoise,
+  UINT first, UINT n) const
+{
+  const size_t nSize = m_nCacheTileSize*m_nCacheTileSize; //pixels per tile
+
+  for(size_t i=first; i<key.size(); i+=n)
+    GetCacheTile(key[i], &pNoise[i*nSize]);
+} //GetCacheTiles
+
+/// Copy the part of a tile that overlaps the bitmap into an array of noise
+/// values for the bitmap.
+/// \param k Tile key.
+/// \param pTile Array of noise values for the tile, row-major.
+/// \param nLeft Pixel grid X-coordinate of the left column of the bitmap.
+/// \param nTop Pixel grid Y-coordinate of the top row of the bitmap.
+/// \param pNoise [OUT] Array of noise values, one per pixel, row-major.
+
+void CMain::CopyTile(const TileKey& k, const float* pTile, int64_t nLeft,
+  int64_t nTop, float* pNoise) const
+{
+  const int64_t n = (int64_t)m_nCacheTileSize; //tile size
+  const int64_t w = (int64_t)m_pBitmap->GetWidth(); //bitmap width
+  const int64_t h = (int64_t)m_pBitmap->GetHeight(); //bitmap height
+
+  const int64_t x = k.nX*n - nLeft; //bitmap column of left of tile
+  const int64_t y = k.nY*n - nTop; //bitmap row of top of tile
+
+  const int64_t i0 = std::max<int64_t>(0, -x); //first tile column in bitmap
+  const int64_t i1 = std::min<int64_t>(n, w - x); //column after last
+  const int64_t j0 = std::max<int64_t>(0, -y); //first tile row in bitmap
+  const int64_t j1 = std::min<int64_t>(n, h - y); //row after last
+
+  if(i0 >= i1)return; //safety
+
+  for(int64_t j=j0; j<j1; j++)
+    memcpy(&pNoise[(y + j)*w + x + i0], &pTile[j*n + i0],
+      (i1 - i0)*sizeof(float));
+} //CopyTile
+
+#pragma endregion Tile cache functions
+
 ///////////////////////////////////////////////////////////////////////////////
 // Menu response functions
 
 #pragma region Menu response functions
 
 /// Change the seed for the noise generator's pseudo-random number generator,
-/// update the gradient/value table using the current distribution,
-/// and regenerate the noise bitmap.
+/// update the gradient/value table using the current distribution and the
+/// permutations, and regenerate the noise bitmap. The noise then depends only
+/// on the seed and the noise settings, which is what the render cache key
+/// assumes.
 
 void CMain::Randomize(){
-  m_pPerlin->SetSeed();
-  m_pPerlin->RandomizeTable(m_pPerlin->GetDistribution());
+  m_pPerlin->Reseed(timeGetTime());
+  Invalidate();
   GenerateNoiseBitmap();
 } //Randomize
 
@@ -418,6 +876,7 @@ bool CMain::SetDistribution(eDistribution d){
   if(m_pPerlin->GetDistribution() != d){
     m_pPerlin->RandomizeTable(d);
     UpdateDistributionMenu(m_hDistMenu, m_eNoise, d);
+    Invalidate();
     GenerateNoiseBitmap();
     return true;
   } //if
@@ -431,15 +890,37 @@ bool CMain::SetDistribution(eDistribution d){
 void CMain::SetSpline(eSpline d){
   m_pPerlin->SetSpline(d);
   UpdateSplineMenu(m_hSplineMenu, m_eNoise, d);
+  Invalidate();
   GenerateNoiseBitmap();
 } //SetSpline
 
+/// Set Worley noise distance and regenerate noise.
+/// \param d Worley noise distance enumerated type.
+
+void CMain::SetWorley(eWorley d){
+  m_pPerlin->SetWorley(d);
+  UpdateWorleyMenu(m_hWorleyMenu, m_eNoise, d);
+  Invalidate();
+  GenerateNoiseBitmap();
+} //SetWorley
+
+/// Set the way that octaves are combined and regenerate noise.
+/// \param d Fractal enumerated type.
+
+void CMain::SetFractal(eFractal d){
+  m_pPerlin->SetFractal(d);
+  UpdateFractalMenu(m_hFractalMenu, m_eNoise, d);
+  Invalidate();
+  GenerateNoiseBitmap();
+} //SetFractal
+
 /// Set Perlin noise hash function and regenerate noise.
 /// \param d Hash function enumerated type.
 
 void CMain::SetHash(eHash d){
   m_pPerlin->SetHash(d);
   UpdateHashMenu(m_hHashMenu, m_eNoise, d);
+  Invalidate();
   GenerateNoiseBitmap();
 } //SetHash
 
@@ -461,13 +942,148 @@ void CMain::ToggleViewGrid(){
   DrawGrid();
 } // ToggleViewGrid
 
+/// Toggle the Fixed-Point Arithmetic flag, put a checkmark next to the menu
+/// item, and regenerate the noise bitmap.
+
+void CMain::ToggleFixedPoint(){
+  m_bFixedPoint = !m_bFixedPoint;
+  UpdateMenuItemCheck(m_hSetMenu, IDM_SETTINGS_FIXED, m_bFixedPoint);
+  Invalidate();
+  GenerateNoiseBitmap();
+} //ToggleFixedPoint
+
+/// Toggle the Cull Octaves flag, put a checkmark next to the menu item, and
+/// regenerate the noise bitmap.
+
+void CMain::ToggleCullOctaves(){
+  m_bCullOctaves = !m_bCullOctaves;
+  UpdateMenuItemCheck(m_hSetMenu, IDM_SETTINGS_CULL, m_bCullOctaves);
+  Invalidate();
+  GenerateNoiseBitmap();
+} //ToggleCullOctaves
+
+/// Toggle the Domain Warp flag, put a checkmark next to the menu item, and
+/// regenerate the noise bitmap.
+
+void CMain::ToggleDomainWarp(){
+  m_bDomainWarp = !m_bDomainWarp;
+  UpdateMenuItemCheck(m_hSetMenu, IDM_SETTINGS_WARP, m_bDomainWarp);
+  Invalidate();
+  GenerateNoiseBitmap();
+} //ToggleDomainWarp
+
+/// Toggle the Animate flag, put a checkmark next to the menu item, and start
+/// or stop the animation timer. The timer fires once per frame time budget,
+/// and animation resumes from the current time.
+
+void CMain::ToggleAnimation(){
+  m_bAnimate = !m_bAnimate;
+  UpdateMenuItemCheck(m_hSetMenu, IDM_SETTINGS_ANIMATE, m_bAnimate);
+
+  if(m_bAnimate){
+    const double t = m_pPerlin->GetTime()/m_fAnimSpeed; //seconds so far
+    m_dwAnimStart = timeGetTime() - (DWORD)(1000.0*t);
+    SetTimer(m_hWnd, m_nAnimTimer, m_nFrameBudget, nullptr);
+  } //if
+
+  else KillTimer(m_hWnd, m_nAnimTimer);
+} //ToggleAnimation
+
+/// Draw the next frame of animation. This should be called in response to
+/// the animation timer. The animation time is taken from the clock rather
+/// than counted in frames, so if a frame takes longer than the frame time
+/// budget `m_nFrameBudget`, then the timer messages that pile up meanwhile
+/// are merged by Windows and the animation skips frames instead of
+/// slowing down. Since the animation time is different every frame, the
+/// caches are not used.
+
+void CMain::NextFrame(){
+  if(!m_bAnimate || m_eNoise == eNoise::None)return;
+
+  const DWORD dwNow = timeGetTime(); //current time in milliseconds
+  m_pPerlin->SetTime(m_fAnimSpeed*(dwNow - m_dwAnimStart)/1000.0);
+  Invalidate();
+  GenerateNoise(false, false);
+  m_dwFrameTime = timeGetTime() - dwNow;
+} //NextFrame
+
+/// Render animation frames at `m_nExportWidth` by `m_nExportHeight` pixels
+/// for one second per 60 frames of animation time, starting at the current
+/// time, and save them as numbered png files. The frames are streamed, that
+/// is, each frame is saved on a separate thread while the next one is being
+/// rendered on all of the others. Frames are looked up in the render cache
+/// first, so exporting the same animation again only has to save them.
+/// The tile cache is not used, so the tiles for the current animation time
+/// are still valid when the bitmap and the animation time are put back
+/// afterwards.
+/// \param wstrFileName File name for the first frame. Its extension, if any,
+/// is replaced by a four-digit frame number and `.png`.
+/// \return A report of the number of frames and the time taken.
+
+const std::wstring CMain::ExportAnimation(const std::wstring& wstrFileName){
+  std::wstring wstrBase = wstrFileName; //file name without extension
+  const size_t nDot = wstrBase.rfind(L'.'); //position of extension, if any
+
+  if(nDot != std::wstring::npos && wstrBase.find(L'\\', nDot) == std::wstring::npos)
+    wstrBase.erase(nDot);
+
+  const INT w = (INT)m_pBitmap->GetWidth(); //window bitmap width
+  const INT h = (INT)m_pBitmap->GetHeight(); //window bitmap height
+  const double t0 = m_pPerlin->GetTime(); //current animation time
+
+  CreateBitmap((INT)m_nExportWidth, (INT)m_nExportHeight);
+
+  std::thread saver; //thread that saves the previous frame
+  Gdiplus::Bitmap* pFrame = nullptr; //copy of the previous frame
+  bool bFailed = false; //true if a frame failed to save
+  double fRender = 0.0; //time spent rendering, in milliseconds
+
+  for(UINT k=0; k<m_nExportFrames; k++){ //for each frame
+    const auto start = std::chrono::high_resolution_clock::now();
+    m_pPerlin->SetTime(t0 + m_fAnimSpeed*k/60.0);
+    GenerateNoise(true, false);
+    fRender += std::chrono::duration<double, std::milli>(
+      std::chrono::high_resolution_clock::now() - start).count();
+
+    if(saver.joinable())saver.join(); //wait for previous frame
+    delete pFrame;
+
+    pFrame = m_pBitmap->Clone(0, 0, (INT)m_nExportWidth, (INT)m_nExportHeight,
+      PixelFormat32bppARGB); //so that the next frame can be rendered
+
+    std::wstring wstrNum = std::to_wstring(k); //frame number
+    while(wstrNum.size() < 4)wstrNum = L"0" + wstrNum; //pad with zeros
+
+    saver = std::thread([&bFailed, pFrame](const std::wstring wstr){
+      if(FAILED(SavePNG(wstr, pFrame)))bFailed = true;
+    }, wstrBase + L"-" + wstrNum + L".png");
+  } //for
+
+  if(saver.joinable())saver.join(); //wait for last frame
+  delete pFrame;
+
+  CreateBitmap(w, h); //put back the window bitmap
+  m_pPerlin->SetTime(t0); //put back the animation time
+  GenerateNoiseBitmap();
+
+  std::wstring wstr = std::to_wstring(m_nExportFrames) + L" frames of ";
+  wstr += std::to_wstring(m_nExportWidth) + L"x" +
+    std::to_wstring(m_nExportHeight) + L" animation ";
+  wstr += bFailed? L"could not all be saved": L"saved";
+  wstr += L" to " + wstrBase + L"-NNNN.png. ";
+  wstr += L"Rendering took " + to_wstring_f(fRender/m_nExportFrames, 1);
+  wstr += L" ms per frame.";
+
+  return wstr;
+} //ExportAnimation
+
 /// Increment both coordinates of the origin by table size and regenerate
 /// the noise bitmap.
 
 void CMain::Jump(){
-  const float offset = (float)m_pPerlin->GetTableSize();
-  m_fOriginX += offset;
-  m_fOriginY += offset;
+  const double offset = (double)m_pPerlin->GetTableSize();
+  m_dOriginX += offset;
+  m_dOriginY += offset;
   GenerateNoiseBitmap();
 } //Jump
 
@@ -475,9 +1091,9 @@ void CMain::Jump(){
 /// \param x New X-coordinate of origin.
 /// \param y New Y-coordinate of origin.
 
-void CMain::Jump(float x, float y){
-  m_fOriginX = x;
-  m_fOriginY = y;
+void CMain::Jump(double x, double y){
+  m_dOriginX = x;
+  m_dOriginY = y;
   GenerateNoiseBitmap();
 } //Jump
 
@@ -486,8 +1102,8 @@ void CMain::Jump(float x, float y){
 /// \param y Desired Y-coordinate of origin.
 /// \return true if the origin coordinates are the desired coordinates.
 
-const bool CMain::Origin(float x, float y) const{
-  return m_fOriginX == x && m_fOriginY == y;
+const bool CMain::Origin(double x, double y) const{
+  return m_dOriginX == x && m_dOriginY == y;
 } //Origin
 
 /// Increase the number of octaves in `m_nOctaves` by one up to a maximum
@@ -495,6 +1111,7 @@ const bool CMain::Origin(float x, float y) const{
 
 void CMain::IncreaseOctaves(){
   m_nOctaves = std::min<size_t>(m_nOctaves + 1, m_nMaxOctaves);
+  Invalidate();
   GenerateNoiseBitmap();
 } //IncreaseOctaves
 
@@ -503,6 +1120,7 @@ void CMain::IncreaseOctaves(){
 
 void CMain::DecreaseOctaves(){
   m_nOctaves = std::max<size_t>(m_nMinOctaves, m_nOctaves - 1);
+  Invalidate();
   GenerateNoiseBitmap();
 } //DecreaseOctaves
 
@@ -510,30 +1128,173 @@ void CMain::DecreaseOctaves(){
 /// of `m_fMaxScale` and regenerate the noise bitmap.
 
 void CMain::IncreaseScale(){
-  m_fScale = std::min<float>(2.0f*m_fScale, m_fMaxScale);
-  GenerateNoiseBitmap();
+  Zoom(true, 0, 0);
 } //IncreaseScale
 
 /// Decrease the scale in `m_fScale` by a factor of 2 down to a minimum
 /// of `m_fMinScale` and regenerate the noise bitmap.
 
 void CMain::DecreaseScale(){
-  m_fScale = std::max<float>(m_fMinScale, m_fScale/2.0f);
-  GenerateNoiseBitmap();
+  Zoom(false, 0, 0);
 } //DecreaseScale
 
+/// Zoom in or out by a factor of 2, that is, double or halve `m_fScale`
+/// within the limits `m_fMinScale` and `m_fMaxScale`, keeping the noise
+/// under a given pixel where it is. This means moving the origin unless the
+/// pixel is the top left one.
+///
+/// The trick is that since the scale changes by a factor of 2 about a pixel,
+/// the new pixel grid lines up with the old one. When zooming in, every
+/// second pixel in each direction is at the same point as a pixel in the old
+/// grid, so only 3/4 of the noise values need to be computed. When zooming
+/// out, the pixels that are still in view are at the points of every second
+/// old pixel in each direction, so those can be reused. The rest are
+/// computed in batches on one thread per hardware thread by
+/// `GetZoomTiles()`, so zooming costs at most as much as a full render.
+/// Old noise values are not reused if there aren't any or if octave culling
+/// is on, since octave culling depends on the scale, or if the tile cache
+/// has any of the new noise values, in which case only the missing tiles
+/// are rendered. Otherwise the tiles that lie entirely inside the bitmap are
+/// put into the tile cache afterwards.
+/// \param bIn true to zoom in (double the scale), false to zoom out.
+/// \param cx X-coordinate of the pixel to zoom about.
+/// \param cy Y-coordinate of the pixel to zoom about.
+/// \return true if the scale changed.
+
+bool CMain::Zoom(bool bIn, int cx, int cy){
+  const float fScale = bIn? 2.0f*m_fScale: m_fScale/2.0f; //new scale
+  if(fScale < m_fMinScale || fScale > m_fMaxScale)return false; //out of range
+
+  //move the origin so that pixel (cx, cy) stays put
+
+  m_dOriginX += cx/(double)m_fScale - cx/(double)fScale;
+  m_dOriginY += cy/(double)m_fScale - cy/(double)fScale;
+  m_fScale = fScale;
+
+  if(m_eNoise == eNoise::None || m_bCullOctaves || HasTiles(false)){ //no reuse
+    GenerateNoiseBitmap();
+    return true;
+  } //if
+
+  UpdateMenus(); //the scale has changed
+
+  const UINT nThreads = max(1U, std::thread::hardware_concurrency());
+  float* pNoise = new float[m_pBitmap->GetWidth()*m_pBitmap->GetHeight()];
+  std::vector<std::thread> thread; //worker threads
+
+  for(UINT i=0; i<nThreads; i++)
+    thread.push_back(std::thread(&CMain::GetZoomTiles, this, pNoise, bIn, cx,
+      cy, i, nThreads));
+
+  for(std::thread& th: thread)
+    th.join();
+
+  delete [] m_fNoise;
+  m_fNoise = pNoise;
+
+  GatherStats(m_fNoise, m_cStats);
+  PutTiles(m_fNoise);
+  DrawNoise();
+  return true;
+} //Zoom
+
+/// Get the noise values for every \f$n\f$-th tile of `m_nTileRows` rows of
+/// pixels starting at a given tile after zooming about a pixel, as in
+/// `GetNoiseTiles()`, but reusing the old noise values in `m_fNoise` for
+/// the pixels that are at the same points as old pixels (see `Zoom()`). The
+/// other pixels of each row are collected into chunks and handed to
+/// `GetNoisePoints()`.
+/// \param pNoise [OUT] Array of noise values, one per pixel, row-major.
+/// \param bIn true if zooming in, false if zooming out.
+/// \param cx X-coordinate of the pixel zoomed about.
+/// \param cy Y-coordinate of the pixel zoomed about.
+/// \param first First tile.
+/// \param n Distance between tiles.
+
+void CMain::GetZoomTiles(float* pNoise, bool bIn, int cx, int cy,
+  UINT first, UINT n) const
+{
+  const int w = (int)m_pBitmap->GetWidth(); //bitmap width
+  const int h = (int)m_pBitmap->GetHeight(); //bitmap height
+  const UINT nChunk = 256; //pixels per chunk
+
+  double pX[nChunk], pY[nChunk]; //coordinates of pixels to compute
+  int pI[nChunk]; //columns of pixels to compute
+  float pResult[nChunk]; //noise values of pixels to compute
+
+  for(UINT k=first; k*m_nTileRows<(UINT)h; k+=n){ //for each tile
+    const int nBottom = (int)min((UINT)h, (k + 1)*m_nTileRows); //row after last
+
+    for(int j=k*m_nTileRows; j<nBottom; j++){
+      const double y = m_dOriginY + j/(double)m_fScale; //noise Y-coordinate
+      float* pRow = &pNoise[j*w]; //row j of new noise values
+      UINT m = 0; //number of pixels in the chunk
+
+      //row of old pixel at the same point as row j, if any
+
+      const int oj = bIn? ((cy + j)%2? -1: (cy + j)/2): 2*j - cy;
+
+      for(int i=0; i<w; i++){
+        //column of old pixel at the same point as column i, if any
+
+        const int oi = bIn? ((cx + i)%2? -1: (cx + i)/2): 2*i - cx;
+
+        if(0 <= oi && oi < w && 0 <= oj && oj < h) //reuse old noise value
+          pRow[i] = m_fNoise[oj*w + oi];
+
+        else{ //add to chunk of new noise values
+          pX[m] = m_dOriginX + i/(double)m_fScale;
+          pY[m] = y;
+          pI[m++] = i;
+        } //else
+
+        if(m == nChunk || (i == w - 1 && m > 0)){ //chunk full or row done
+          GetNoisePoints(pX, pY, m, pResult);
+          for(UINT q=0; q<m; q++)pRow[pI[q]] = pResult[q];
+          m = 0;
+        } //if
+      } //for
+    } //for
+  } //for
+} //GetZoomTiles
+
+/// Zoom in or out by a factor of 2 about a point in the window client area,
+/// for example, the mouse cursor position. Nothing happens if the point
+/// is not over the bitmap.
+/// \param bIn true to zoom in (double the scale), false to zoom out.
+/// \param x X-coordinate of point in the client area.
+/// \param y Y-coordinate of point in the client area.
+/// \return true if the scale changed.
+
+bool CMain::ZoomClient(bool bIn, int x, int y){
+  const Gdiplus::Rect r = GetDestRect(); //where the bitmap is drawn
+
+  if(m_eNoise == eNoise::None || r.Width <= 0 || r.Height <= 0 ||
+    x < r.X || x >= r.X + r.Width || y < r.Y || y >= r.Y + r.Height)
+      return false; //not over the bitmap
+
+  const int cx = (x - r.X)*(int)m_pBitmap->GetWidth()/r.Width; //pixel x
+  const int cy = (y - r.Y)*(int)m_pBitmap->GetHeight()/r.Height; //pixel y
+
+  return Zoom(bIn, cx, cy);
+} //ZoomClient
+
 /// Increase the table size by a factor of 2 and regenerate the noise bitmap.
 
 void CMain::IncreaseTableSize(){
-  if(m_pPerlin->DoubleTableSize())
+  if(m_pPerlin->DoubleTableSize()){
+    Invalidate();
     GenerateNoiseBitmap();
+  } //if
 } //IncreaseTableSize
 
 /// Decrease the table size by a factor of 2 and regenerate the noise bitmap.
 
 void CMain::DecreaseTableSize(){
-  if(m_pPerlin->HalveTableSize())
+  if(m_pPerlin->HalveTableSize()){
+    Invalidate();
     GenerateNoiseBitmap();
+  } //if
 } //DecreaseTableSize
 
 /// Reset number of octaves, scale, and table size to defaults and regenerate
@@ -543,11 +1304,812 @@ void CMain::Reset(){
   m_nOctaves = m_nDefOctaves;
   m_fScale = m_fDefScale;
   m_pPerlin->DefaultTableSize();
+  Invalidate();
   GenerateNoiseBitmap();
 } //Reset
 
 #pragma endregion Menu response functions
 
+///////////////////////////////////////////////////////////////////////////////
+// Benchmark functions
+
+#pragma region Benchmark functions
+
+/// Fill arrays with the coordinates of a fixed set of pseudo-random points
+/// for benchmarking. The points are spread over a square big enough that
+/// lookups land all over the largest permutation, so that timings include
+/// the effect of cache misses.
+/// \param pX [OUT] Array of X-coordinates.
+/// \param pY [OUT] Array of Y-coordinates.
+/// \param n Number of points.
+
+void CMain::RandomPoints(double* pX, double* pY, size_t n) const{
+  std::default_random_engine r; //PRNG with default seed
+  std::uniform_real_distribution<double> d(0.0, 16777216.0); //coordinates
+
+  for(size_t i=0; i<n; i++){
+    pX[i] = d(r);
+    pY[i] = d(r);
+  } //for
+} //RandomPoints
+
+/// Time how long a noise generator takes to compute the current number of
+/// octaves of noise at each of the points from `RandomPoints()` using
+/// its batch function.
+/// \param perlin Noise generator.
+/// \param t Noise type.
+/// \return Average time per point in nanoseconds.
+
+const double CMain::TimeNoise(const CPerlinNoise2D& perlin, eNoise t) const{
+  const size_t n = 1 << 18; //number of points
+
+  double* pX = new double[n]; //X-coordinates
+  double* pY = new double[n]; //Y-coordinates
+  float* pResult = new float[n]; //noise values
+
+  RandomPoints(pX, pY, n);
+
+  const auto start = std::chrono::steady_clock::now(); //start time
+  perlin.generatebatch(pX, pY, n, pResult, t, m_nOctaves);
+  const auto stop = std::chrono::steady_clock::now(); //stop time
+
+  delete [] pX;
+  delete [] pY;
+  delete [] pResult;
+
+  return std::chrono::duration<double, std::nano>(stop - start).count()/n;
+} //TimeNoise
+
+/// Time noise generation for several distributions with the same seed,
+/// spline function, fractal, and instruction set as the current noise,
+/// first with a separate call to `CPerlinNoise2D::generatebatch()` for each
+/// distribution, then with a single call to
+/// `CPerlinNoise2D::generatefused()` for all of them. The two are written
+/// to different arrays and compared afterwards, since the fused version is
+/// supposed to give bit-for-bit the same values.
+/// \param dist Array of distributions.
+/// \param n Number of distributions.
+/// \param t Noise type.
+/// \param dSeparate [OUT] Time for separate calls, in nanoseconds per point
+/// per distribution.
+/// \param dFused [OUT] Time for a fused call, in nanoseconds per point per
+/// distribution.
+/// \param nMismatch [OUT] Number of values that differ between the two.
+
+void CMain::TimeFusedNoise(const eDistribution* dist, size_t n, eNoise t,
+  double& dSeparate, double& dFused, size_t& nMismatch) const
+{
+  const size_t m = 1 << 18; //number of points
+
+  double* pX = new double[m]; //X-coordinates
+  double* pY = new double[m]; //Y-coordinates
+  float* pResult = new float[n*m]; //noise values for all distributions
+  float* pFused = new float[n*m]; //fused noise values for all distributions
+
+  CPerlinNoise2D* pPerlin = new CPerlinNoise2D[n]; //noise generators
+  const CPerlinNoise2D** pGen = new const CPerlinNoise2D*[n]; //pointers to them
+  float** pOut = new float*[n]; //pointers to fused noise values
+
+  for(size_t i=0; i<n; i++){
+    pPerlin[i].SetSpline(m_pPerlin->GetSpline());
+    pPerlin[i].SetFractal(m_pPerlin->GetFractal());
+    pPerlin[i].SetISA(m_pPerlin->GetISA());
+    pPerlin[i].RandomizeTable(dist[i]);
+    pPerlin[i].Reseed(m_pPerlin->GetSeed()); //same lattice for all
+    pGen[i] = &pPerlin[i];
+    pOut[i] = pFused + i*m;
+  } //for
+
+  RandomPoints(pX, pY, m);
+
+  const auto start = std::chrono::steady_clock::now(); //start time
+
+  for(size_t i=0; i<n; i++)
+    pPerlin[i].generatebatch(pX, pY, m, pResult + i*m, t, m_nOctaves);
+
+  const auto mid = std::chrono::steady_clock::now(); //separate stop time
+  pPerlin[0].generatefused(pX, pY, m, pGen, n, pOut, t, m_nOctaves);
+  const auto stop = std::chrono::steady_clock::now(); //fused stop time
+
+  dSeparate = std::chrono::duration<double, std::nano>(mid - start).count();
+  dFused = std::chrono::duration<double, std::nano>(stop - mid).count();
+
+  dSeparate /= n*m; //per point per distribution
+  dFused /= n*m; //per point per distribution
+
+  nMismatch = 0;
+
+  for(size_t i=0; i<n*m; i++)
+    if(pFused[i] != pResult[i])nMismatch++;
+
+  delete [] pOut;
+  delete [] pGen;
+  delete [] pPerlin;
+  delete [] pX;
+  delete [] pY;
+  delete [] pResult;
+  delete [] pFused;
+} //TimeFusedNoise
+
+/// Time the generation of `m_nPatchCount` square patches of noise of width
+/// `m_nPatchSize` with different seeds and the current noise settings,
+/// first the naive way with a new noise generator for each seed and a call
+/// to `CPerlinNoise2D::generatebatch()` for each row on the same instruction
+/// set, then with a single call to `CPerlinNoise2D::generatepatches()`. The
+/// two are written to different arrays and compared afterwards, since they
+/// are supposed to give bit-for-bit the same values.
+/// \param t Noise type.
+/// \param dNaive [OUT] Time for the naive way, in nanoseconds per point.
+/// \param dBatch [OUT] Time for `CPerlinNoise2D::generatepatches()`, in
+/// nanoseconds per point.
+/// \param nMismatch [OUT] Number of values that differ between the two.
+
+void CMain::TimePatches(eNoise t, double& dNaive, double& dBatch,
+  size_t& nMismatch) const
+{
+  PatchRegion r; //region covered by each patch
+  r.dX = m_dOriginX;
+  r.dY = m_dOriginY;
+  r.fScale = m_fScale;
+  r.nWidth = r.nHeight = m_nPatchSize;
+
+  const size_t nSize = r.nWidth*r.nHeight; //number of points per patch
+  UINT* pSeed = new UINT[m_nPatchCount]; //seeds
+  float* pNaive = new float[m_nPatchCount*nSize]; //noise values, naive way
+  float* pResult = new float[m_nPatchCount*nSize]; //noise values, batched
+  double* pX = new double[r.nWidth]; //X-coordinates of a row
+  double* pY = new double[r.nWidth]; //Y-coordinates of a row
+
+  for(size_t k=0; k<m_nPatchCount; k++)
+    pSeed[k] = m_pPerlin->GetSeed() + (UINT)k;
+
+  for(size_t i=0; i<r.nWidth; i++)
+    pX[i] = r.dX + i/(double)r.fScale;
+
+  const auto start = std::chrono::steady_clock::now(); //start time
+
+  for(size_t k=0; k<m_nPatchCount; k++){ //the naive way
+    CPerlinNoise2D perlin; //noise generator for this seed
+
+    while(perlin.GetTableSize() < m_pPerlin->GetTableSize())
+      perlin.DoubleTableSize();
+    while(perlin.GetTableSize() > m_pPerlin->GetTableSize())
+      perlin.HalveTableSize();
+
+    perlin.SetHash(m_pPerlin->GetHash());
+    perlin.SetSpline(m_pPerlin->GetSpline());
+    perlin.SetWorley(m_pPerlin->GetWorley());
+    perlin.SetFractal(m_pPerlin->GetFractal());
+    perlin.SetISA(m_pPerlin->GetISA());
+    perlin.RandomizeTable(m_pPerlin->GetDistribution());
+    perlin.SetTime(m_pPerlin->GetTime());
+    perlin.Reseed(pSeed[k]);
+
+    for(size_t j=0; j<r.nHeight; j++){ //for each row
+      std::fill(pY, pY + r.nWidth, r.dY + j/(double)r.fScale);
+      perlin.generatebatch(pX, pY, r.nWidth, pNaive + k*nSize + j*r.nWidth,
+        t, m_nOctaves);
+    } //for
+  } //for
+
+  const auto mid = std::chrono::steady_clock::now(); //naive stop time
+  m_pPerlin->generatepatches(pSeed, m_nPatchCount, r, pResult, t, m_nOctaves);
+  const auto stop = std::chrono::steady_clock::now(); //batch stop time
+
+  dNaive = std::chrono::duration<double, std::nano>(mid - start).count();
+  dBatch = std::chrono::duration<double, std::nano>(stop - mid).count();
+
+  dNaive /= m_nPatchCount*nSize; //per point
+  dBatch /= m_nPatchCount*nSize; //per point
+
+  nMismatch = 0;
+
+  for(size_t i=0; i<m_nPatchCount*nSize; i++)
+    if(pResult[i] != pNaive[i])nMismatch++;
+
+  delete [] pSeed;
+  delete [] pNaive;
+  delete [] pResult;
+  delete [] pX;
+  delete [] pY;
+} //TimePatches
+
+/// Measure how much noise repeats by computing the correlation coefficient
+/// between the noise at each of the points from `RandomPoints()` and the
+/// noise at the same point moved along the X-axis. If the hash function
+/// repeats with a period that divides the distance moved, then this will be
+/// 1, whereas for a good hash function it will be close to 0.
+/// \param perlin Noise generator.
+/// \param t Noise type.
+/// \param d Distance moved.
+/// \return Correlation coefficient in \f$[-1, 1]\f$.
+
+const double CMain::CorrelateNoise(const CPerlinNoise2D& perlin, eNoise t,
+  double d) const
+{
+  const size_t n = 1 << 16; //number of points
+
+  double* pX = new double[n]; //X-coordinates
+  double* pY = new double[n]; //Y-coordinates
+  float* pA = new float[n]; //noise values
+  float* pB = new float[n]; //noise values at moved points
+
+  RandomPoints(pX, pY, n);
+  perlin.generatebatch(pX, pY, n, pA, t, m_nOctaves);
+
+  for(size_t i=0; i<n; i++)
+    pX[i] += d;
+
+  perlin.generatebatch(pX, pY, n, pB, t, m_nOctaves);
+
+  double sa = 0, sb = 0, saa = 0, sbb = 0, sab = 0; //sums
+
+  for(size_t i=0; i<n; i++){
+    sa  += pA[i];       sb  += pB[i];
+    saa += pA[i]*pA[i]; sbb += pB[i]*pB[i]; sab += pA[i]*pB[i];
+  } //for
+
+  delete [] pX;
+  delete [] pY;
+  delete [] pA;
+  delete [] pB;
+
+  const double cov = sab - sa*sb/n; //scaled covariance
+  const double var = sqrt((saa - sa*sa/n)*(sbb - sb*sb/n)); //scaled variance
+
+  return (var > 0.0)? cov/var: 0.0;
+} //CorrelateNoise
+
+/// Render a large field of noise a tile at a time, using the current number
+/// of octaves and scale, and accumulate its power spectrum. The tiles are
+/// side by side along the X-axis so that they are all different.
+/// \param perlin Noise generator.
+/// \param t Noise type.
+/// \param spectrum [OUT] Power spectrum.
+
+void CMain::AnalyzeSpectrum(const CPerlinNoise2D& perlin, eNoise t,
+  CSpectrum& spectrum) const
+{
+  const size_t w = spectrum.GetSize(); //tile width
+  const size_t n = w*w; //number of points per tile
+  const UINT nThreads = max(1U, std::thread::hardware_concurrency());
+
+  double* pX = new double[n]; //X-coordinates
+  double* pY = new double[n]; //Y-coordinates
+  float* pResult = new float[n]; //noise values
+
+  spectrum.Clear();
+
+  for(size_t k=0; k<m_nSpectrumTiles; k++){ //for each tile
+    for(size_t j=0; j<w; j++)
+      for(size_t i=0; i<w; i++){
+        pX[j*w + i] = (k*w + i)/(double)m_fScale;
+        pY[j*w + i] = j/(double)m_fScale;
+      } //for
+
+    perlin.generatebatch(pX, pY, n, pResult, t, m_nOctaves);
+    spectrum.Add(pResult, nThreads);
+  } //for
+
+  delete [] pX;
+  delete [] pY;
+  delete [] pResult;
+} //AnalyzeSpectrum
+
+/// Describe a power spectrum by the percentage of its power in each octave
+/// band, its anisotropy, and its distance from a reference spectrum.
+/// \param spectrum Power spectrum.
+/// \param ref Reference power spectrum.
+/// \return Wide string description.
+
+const std::wstring CMain::DescribeSpectrum(const CSpectrum& spectrum,
+  const CSpectrum& ref) const
+{
+  std::wstring wstr; //result
+
+  for(size_t k=0; k<spectrum.GetNumBands(); k++){
+    if(k > 0)wstr += L"/";
+    wstr += to_wstring_f(100.0*spectrum.GetBand(k), 0);
+  } //for
+
+  wstr += L", " + to_wstring_f(spectrum.GetAnisotropy(), 2);
+  wstr += L", " + to_wstring_f(spectrum.GetDistance(ref), 2);
+
+  return wstr;
+} //DescribeSpectrum
+
+/// Run benchmarks and report the results. The permutation hash is timed for
+/// each table size from the minimum to the maximum using a separate noise
+/// generator with the same spline function, distribution, and instruction
+/// set as the current one, so the current noise is not disturbed. Then
+/// each noise type is timed at the default table size. Finally,
+/// each hash function is timed at the default table size using scalar code,
+/// so that they are compared on an equal footing, and its quality measured
+/// by how much the noise repeats one table width away and by its power
+/// spectrum. The spectrum of each distribution and spline function is
+/// reported in the same way, next to its time, so that a cheaper setting
+/// whose spectrum is close to that of a more expensive one stands out.
+/// The distributions are also timed all together, separately and fused,
+/// using the current instruction set, and so is the generation of many
+/// small patches of noise with different seeds.
+/// \return Wide string benchmark report.
+
+const std::wstring CMain::Benchmark() const{
+  const eNoise t = (m_eNoise == eNoise::None)? eNoise::Perlin: m_eNoise;
+
+  std::wstring wstr = std::to_wstring(m_nOctaves) + L" octave";
+  if(m_nOctaves > 1)wstr += L"s";
+
+  switch(t){
+    case eNoise::Perlin:  wstr += L" of Perlin";  break;
+    case eNoise::Value:   wstr += L" of Value";   break;
+    case eNoise::Simplex: wstr += L" of Simplex"; break;
+    case eNoise::Worley:  wstr += L" of Worley";  break;
+  } //switch
+
+  wstr += L" Noise at random points using ";
+
+  switch(m_pPerlin->GetISA()){
+    case eISA::Scalar: wstr += L"scalar code"; break;
+    case eISA::SSE2:   wstr += L"SSE2";        break;
+    case eISA::AVX2:   wstr += L"AVX2";        break;
+    case eISA::AVX512: wstr += L"AVX-512";     break;
+  } //switch
+
+  wstr += L", in nanoseconds per point.\n\n";
+
+  //permutation hash against table size
+
+  CPerlinNoise2D perlin; //noise generator for benchmarks
+  perlin.SetSpline(m_pPerlin->GetSpline());
+  perlin.SetISA(m_pPerlin->GetISA());
+  perlin.RandomizeTable(m_pPerlin->GetDistribution());
+
+  wstr += L"Permutation hash by table size:\n";
+  while(perlin.HalveTableSize()); //start at the minimum table size
+
+  do{
+    wstr += std::to_wstring(perlin.GetTableSize()) + L": ";
+    wstr += to_wstring_f(TimeNoise(perlin, t), 1) + L"\n";
+  }while(perlin.DoubleTableSize());
+
+  //noise types
+
+  const eNoise noise[] = {eNoise::Perlin, eNoise::Value,
+    eNoise::Simplex, eNoise::Worley}; //noise types
+  const std::wstring noisename[] = {L"Perlin", L"Value",
+    L"Simplex", L"Worley"}; //their names
+
+  perlin.DefaultTableSize();
+  wstr += L"\nNoise type at table size ";
+  wstr += std::to_wstring(perlin.GetTableSize()) + L":\n";
+
+  for(size_t i=0; i<sizeof(noise)/sizeof(eNoise); i++)
+    wstr += noisename[i] + L": " + to_wstring_f(TimeNoise(perlin, noise[i]), 1)
+      + L"\n";
+
+  //hash functions
+
+  const eHash hash[] = {eHash::Permutation, eHash::LinearCongruential,
+    eHash::Std, eHash::Stateless, eHash::Coprime}; //hash functions
+  const std::wstring name[] = {L"Permutation", L"Linear congruential",
+    L"Std::hash", L"Table-free", L"Coprime permutations"}; //their names
+
+  perlin.SetISA(eISA::Scalar);
+
+  const double d = (double)perlin.GetTableSize(); //distance for correlation
+
+  CSpectrum ref(m_nSpectrumSize); //spectrum of the first setting in a section
+  CSpectrum spectrum(m_nSpectrumSize); //spectrum of the other settings
+
+  wstr += L"\nThe power spectra below are of " +
+    std::to_wstring(m_nSpectrumTiles) + L" tiles of ";
+  wstr += std::to_wstring(m_nSpectrumSize) + L"x" +
+    std::to_wstring(m_nSpectrumSize) + L" pixels at the current scale. ";
+  wstr += L"Each is given as the percentage of power in octave bands of ";
+  wstr += L"1, 2, 4, ... cycles per tile, the anisotropy (0 if the power ";
+  wstr += L"does not depend on direction), and the distance from the first ";
+  wstr += L"spectrum in its section (0 if they have the same shape).\n";
+
+  wstr += L"\nHash function by scalar time, correlation at distance ";
+  wstr += std::to_wstring(perlin.GetTableSize()) + L", and spectrum:\n";
+
+  for(size_t i=0; i<sizeof(hash)/sizeof(eHash); i++){
+    perlin.SetHash(hash[i]);
+    wstr += name[i] + L": " + to_wstring_f(TimeNoise(perlin, t), 1) + L", ";
+    wstr += to_wstring_f(CorrelateNoise(perlin, t, d), 2) + L", ";
+    AnalyzeSpectrum(perlin, t, (i == 0)? ref: spectrum);
+    wstr += DescribeSpectrum((i == 0)? ref: spectrum, ref) + L"\n";
+  } //for
+
+  perlin.SetHash(m_pPerlin->GetHash());
+
+  //distributions
+
+  const eDistribution dist[] = {eDistribution::Uniform, eDistribution::Cosine,
+    eDistribution::Normal, eDistribution::Exponential,
+    eDistribution::Midpoint, eDistribution::Maximal}; //distributions
+  const std::wstring distname[] = {L"Uniform", L"Cosine", L"Normal",
+    L"Exponential", L"Midpoint displacement", L"Maximal"}; //their names
+
+  wstr += L"\nDistribution by scalar time and spectrum:\n";
+
+  for(size_t i=0; i<sizeof(dist)/sizeof(eDistribution); i++){
+    perlin.RandomizeTable(dist[i]);
+    wstr += distname[i] + L": " + to_wstring_f(TimeNoise(perlin, t), 1) +
+      L", ";
+    AnalyzeSpectrum(perlin, t, (i == 0)? ref: spectrum);
+    wstr += DescribeSpectrum((i == 0)? ref: spectrum, ref) + L"\n";
+  } //for
+
+  perlin.RandomizeTable(m_pPerlin->GetDistribution());
+
+  //all distributions at once
+
+  double dSeparate = 0.0, dFused = 0.0; //times per point per distribution
+  size_t nFusedMismatch = 0; //number of fused values that differ
+  TimeFusedNoise(dist, sizeof(dist)/sizeof(eDistribution), t, dSeparate,
+    dFused, nFusedMismatch);
+
+  wstr += L"\nAll distributions with the same seed: separately ";
+  wstr += to_wstring_f(dSeparate, 1) + L", fused " + to_wstring_f(dFused, 1);
+  wstr += L" per distribution, speedup " +
+    to_wstring_f(dSeparate/dFused, 1) + L"x, ";
+  wstr += (nFusedMismatch == 0)? L"identical\n":
+    std::to_wstring(nFusedMismatch) + L" values DIFFER\n";
+
+  //spline functions
+
+  const eSpline spline[] = {eSpline::Quintic, eSpline::Cubic,
+    eSpline::None}; //spline functions
+  const std::wstring splinename[] = {L"Quintic", L"Cubic", L"None"};
+
+  wstr += L"\nSpline function by scalar time and spectrum:\n";
+
+  for(size_t i=0; i<sizeof(spline)/sizeof(eSpline); i++){
+    perlin.SetSpline(spline[i]);
+    wstr += splinename[i] + L": " + to_wstring_f(TimeNoise(perlin, t), 1) +
+      L", ";
+    AnalyzeSpectrum(perlin, t, (i == 0)? ref: spectrum);
+    wstr += DescribeSpectrum((i == 0)? ref: spectrum, ref) + L"\n";
+  } //for
+
+  //patches with different seeds
+
+  double dNaive = 0.0, dBatch = 0.0; //times per point
+  size_t nPatchMismatch = 0; //number of batched values that differ
+  TimePatches(t, dNaive, dBatch, nPatchMismatch);
+
+  wstr += L"\n" + std::to_wstring(m_nPatchCount) + L" patches of ";
+  wstr += std::to_wstring(m_nPatchSize) + L"x" + std::to_wstring(m_nPatchSize);
+  wstr += L" pixels with different seeds: one generator per seed ";
+  wstr += to_wstring_f(dNaive, 1) + L", batched " + to_wstring_f(dBatch, 1);
+  wstr += L", speedup " + to_wstring_f(dNaive/dBatch, 1) + L"x, ";
+  wstr += (nPatchMismatch == 0)? L"identical\n":
+    std::to_wstring(nPatchMismatch) + L" values DIFFER\n";
+
+  //reproducibility of statistics
+
+  if(m_eNoise != eNoise::None){
+    const UINT w = m_pBitmap->GetWidth(); //bitmap width
+    const UINT h = m_pBitmap->GetHeight(); //bitmap height
+    const UINT nMax = max(1U, std::thread::hardware_concurrency()); //threads
+    const UINT nTiles = (h + m_nTileRows - 1)/m_nTileRows; //number of tiles
+
+    float* pNoise = new float[w*h]; //noise values
+    CNoiseStats stats1, stats; //statistics for 1 thread and for more
+    bool bSame = true; //whether they are the same
+
+    RenderNoise(pNoise, 1, stats1);
+
+    for(UINT n=2; n<=nMax; n++){
+      RenderNoise(pNoise, n, stats);
+      bSame = bSame && stats == stats1;
+    } //for
+
+    RenderNoise(pNoise, nTiles + 1, stats); //more threads than tiles
+    bSame = bSame && stats == stats1;
+
+    delete [] pNoise;
+
+    wstr += L"\nStatistics of the current image rendered with 1 to ";
+    wstr += std::to_wstring(nMax) + L" and " + std::to_wstring(nTiles + 1);
+    wstr += L" threads are ";
+    wstr += bSame? L"identical.\n": L"NOT identical.\n";
+  } //if
+
+  return wstr;
+} //Benchmark
+
+/// Render the golden images for regression tests with the current
+/// instruction set and save them to a file. This should be done with a
+/// version of the noise generator that is known to be good.
+/// \param wstrFileName File name.
+/// \return Wide string report.
+
+const std::wstring CMain::SaveGolden(const std::wstring& wstrFileName) const{
+  CGolden golden; //golden images
+  golden.Generate(m_pPerlin->GetISA());
+
+  std::ofstream s(wstrFileName.c_str(), std::ios::binary); //output file
+  golden.Save(s);
+
+  if(!s)return L"Could not save golden images to " + wstrFileName + L".";
+
+  return std::to_wstring(golden.GetNumConfigs()) +
+    L" golden images saved to " + wstrFileName + L".";
+} //SaveGolden
+
+/// Render the golden images with the current instruction set and compare
+/// them with the ones in a file. The full report, with the maximum error
+/// for each configuration, is saved to a text file with the same name
+/// followed by `.txt`, and its summary line is returned.
+/// \param wstrFileName File name.
+/// \return Wide string report.
+
+const std::wstring CMain::CheckGolden(const std::wstring& wstrFileName) const{
+  CGolden ref; //golden images known to be good
+  std::ifstream in(wstrFileName.c_str(), std::ios::binary); //input file
+
+  if(!ref.Load(in))
+    return L"Could not load golden images from " + wstrFileName + L".";
+
+  CGolden golden; //golden images from the current code
+  golden.Generate(m_pPerlin->GetISA());
+
+  const std::wstring wstrReport = golden.Compare(ref, m_fGoldenTolerance);
+  std::wofstream out((wstrFileName + L".txt").c_str()); //report file
+  out << wstrReport;
+
+  std::wstring wstr = wstrReport.substr(0, wstrReport.find(L'\n'));
+  wstr += out? L"\nReport saved to ": L"\nCould not save report to ";
+
+  return wstr + wstrFileName + L".txt.";
+} //CheckGolden
+
+/// Run the differential fuzzer on every fast evaluation path, seeded with
+/// the time so that each run tries different cases. The seed is in the
+/// report so that a failing run can be repeated.
+/// \return Wide string report.
+
+const std::wstring CMain::Fuzz() const{
+  CFuzzer fuzzer(timeGetTime()); //differential fuzzer
+  return fuzzer.Run(m_nFuzzCases);
+} //Fuzz
+
+#pragma endregion Benchmark functions
+
+///////////////////////////////////////////////////////////////////////////////
+// Seed search functions
+
+#pragma region Seed search functions
+
+/// Get the largest absolute difference between the noise values at
+/// horizontally or vertically adjacent pixels, that is, the maximum slope
+/// in noise units per pixel.
+/// \param pNoise Array of noise values, row-major.
+/// \param w Width in pixels.
+/// \param h Height in pixels.
+/// \return Maximum slope.
+
+const float CMain::GetMaxSlope(const float* pNoise, size_t w, size_t h) const{
+  float fMax = 0.0f; //result
+
+  for(size_t j=0; j<h; j++){
+    const float* p = pNoise + j*w; //this row
+
+    for(size_t i=0; i+1<w; i++)
+      fMax = std::max<float>(fMax, fabsf(p[i + 1] - p[i]));
+
+    if(j + 1 < h)
+      for(size_t i=0; i<w; i++)
+        fMax = std::max<float>(fMax, fabsf(p[i + w] - p[i]));
+  } //for
+
+  return fMax;
+} //GetMaxSlope
+
+/// Score noise against the seed search targets. The score is the largest of
+/// the error in the mean and the error in the sea level that gives the
+/// target land fraction, each divided by `m_fSearchTolerance`, and the
+/// maximum slope divided by `m_fTargetSlope`. The noise hits the targets if
+/// the score is at most 1, and lower is better.
+/// \param stats Statistics of the noise.
+/// \param fSlope Maximum slope of the noise.
+/// \return Score.
+
+const float CMain::ScoreNoise(const CNoiseStats& stats, float fSlope) const{
+  const float fMean = (float)stats.GetMean() - m_fTargetMean; //error in mean
+  const float fSea = stats.GetPercentile(1.0f - m_fTargetLand) - m_fSeaLevel;
+  const float fError = std::max<float>(fabsf(fMean), fabsf(fSea));
+
+  return std::max<float>(fError/m_fSearchTolerance, fSlope/m_fTargetSlope);
+} //ScoreNoise
+
+/// Score candidate seeds on a coarse proxy of the bitmap, then reject and
+/// sort them for `SearchSeeds()`. The proxy samples every \f$f\f$-th pixel of
+/// the bitmap in each direction, and is generated for all of the
+/// candidates at once by `CPerlinNoise2D::generatepatches()` using all
+/// cores. Since the slope between two proxy pixels is the average of the
+/// slopes between the \f$f\f$ pairs of bitmap pixels between them, the
+/// maximum slope of the proxy divided by \f$f\f$ is a lower bound for the
+/// maximum slope of the bitmap. A candidate for which this bound is over
+/// `m_fTargetSlope` cannot hit the targets, so it is rejected, unless that
+/// would reject them all. The mean and land fraction of the proxy are only
+/// estimates, so the rest are sorted by score and the caller keeps the best.
+/// The proxy is plain noise, so this is only called when
+/// `CanSearchSeeds()` is true.
+/// \param vSeed [IN, OUT] Candidate seeds, best first on return.
+/// \param f Proxy pixel spacing in bitmap pixels.
+/// \return Number of candidates rejected.
+
+const size_t CMain::ScoreProxies(std::vector<UINT>& vSeed, UINT f) const{
+  const UINT w = m_pBitmap->GetWidth(); //bitmap width
+  const UINT h = m_pBitmap->GetHeight(); //bitmap height
+  const size_t n = vSeed.size(); //number of candidates
+
+  PatchRegion r; //proxy region
+  r.dX = m_dOriginX;
+  r.dY = m_dOriginY;
+  r.fScale = m_fScale/f;
+  r.nWidth = (w + f - 1)/f;
+  r.nHeight = (h + f - 1)/f;
+
+  const size_t nSize = r.nWidth*r.nHeight; //number of proxy pixels
+  float* pProxy = new float[n*nSize]; //proxy for each candidate
+  m_pPerlin->generatepatches(vSeed.data(), n, r, pProxy, m_eNoise, m_nOctaves);
+
+  std::vector<float> vScore(n); //score of each candidate
+  std::vector<bool> vReject(n); //whether each candidate is rejected
+  size_t nReject = 0; //number of candidates rejected
+
+  for(size_t k=0; k<n; k++){
+    const float* p = pProxy + k*nSize; //proxy for this candidate
+    CNoiseStats stats; //statistics of proxy
+
+    for(size_t j=0; j<r.nHeight; j++)
+      stats.Add(p + j*r.nWidth, r.nWidth);
+
+    const float fSlope = GetMaxSlope(p, r.nWidth, r.nHeight)/f; //lower bound
+    vScore[k] = ScoreNoise(stats, fSlope);
+    vReject[k] = fSlope > m_fTargetSlope;
+    if(vReject[k])nReject++;
+  } //for
+
+  delete [] pProxy;
+
+  if(nReject == n){ //keep the least bad
+    std::fill(vReject.begin(), vReject.end(), false);
+    nReject = 0;
+  } //if
+
+  std::vector<size_t> vIndex(n); //candidate indices
+  for(size_t k=0; k<n; k++)vIndex[k] = k;
+
+  std::stable_sort(vIndex.begin(), vIndex.end(), [&](size_t a, size_t b){
+    return vScore[a] < vScore[b];});
+
+  std::vector<UINT> vSorted; //surviving seeds, best first
+
+  for(const size_t k: vIndex)
+    if(!vReject[k])vSorted.push_back(vSeed[k]);
+
+  vSeed.swap(vSorted);
+  return nReject;
+} //ScoreProxies
+
+/// Determine whether the seed search supports the current settings. The
+/// proxies in `ScoreProxies()` are plain noise, so the search is not
+/// available for fixed-point, culled, or domain warped noise, since their
+/// proxies would not match the bitmap.
+/// \return true if the seed search supports the current settings.
+
+const bool CMain::CanSearchSeeds() const{
+  return !m_bFixedPoint && !m_bCullOctaves && !m_bDomainWarp;
+} //CanSearchSeeds
+
+/// Search for a seed whose noise hits the targets for the mean, the
+/// fraction of land above sea level, and the maximum slope (see
+/// `ScoreNoise()`), with the current noise settings and view. There are
+/// `m_nSearchSeeds` candidates. They are scored on proxies with pixel
+/// spacing \f$2^{\mathsf{m\_nSearchLevels}}\f$, and only the best of every
+/// `m_nSearchKeep` is kept. This is repeated with the spacing halved until it
+/// is 2. The survivors are the finalists, which are rendered in full one at
+/// a time, best first, using `RenderNoise()`, so that their statistics are
+/// exactly those of the bitmap. The search stops at the first finalist that
+/// hits the targets. The best finalist is then generated as if by
+/// `Randomize()`.
+/// \return Wide string report.
+
+const std::wstring CMain::SearchSeeds(){
+  if(!CanSearchSeeds())
+    return L"Seed search is not available for fixed-point, culled, or domain "
+      L"warped noise.\n";
+
+  const auto start = std::chrono::steady_clock::now(); //start time
+  const UINT w = m_pBitmap->GetWidth(); //bitmap width
+  const UINT h = m_pBitmap->GetHeight(); //bitmap height
+  const UINT nThreads = max(1U, std::thread::hardware_concurrency());
+  const UINT nBase = timeGetTime(); //first candidate seed
+
+  std::vector<UINT> vSeed(m_nSearchSeeds); //candidate seeds
+  for(size_t k=0; k<m_nSearchSeeds; k++)vSeed[k] = nBase + (UINT)k;
+
+  std::wstring wstr = L"Searched " + std::to_wstring(m_nSearchSeeds);
+  wstr += L" seeds for mean " + to_wstring_f(m_fTargetMean, 2);
+  wstr += L", " + to_wstring_f(100.0f*m_fTargetLand, 0) + L"% above sea level ";
+  wstr += to_wstring_f(m_fSeaLevel, 2) + L" (mean and sea level to within ";
+  wstr += to_wstring_f(m_fSearchTolerance, 2) + L"), and slope at most ";
+  wstr += to_wstring_f(m_fTargetSlope, 3) + L" per pixel.\n\n";
+
+  //proxies
+
+  for(size_t i=m_nSearchLevels; i>0; i--){
+    const UINT f = 1U << i; //proxy pixel spacing
+    const size_t n = vSeed.size(); //number of candidates
+    const size_t nReject = ScoreProxies(vSeed, f);
+
+    vSeed.resize(std::max<size_t>(1, std::min<size_t>(vSeed.size(),
+      n/m_nSearchKeep))); //keep the best
+
+    wstr += L"1/" + std::to_wstring(f) + L" resolution: ";
+    wstr += std::to_wstring(n) + L" candidates, ";
+    wstr += std::to_wstring(nReject) + L" rejected by slope bound, ";
+    wstr += std::to_wstring(vSeed.size()) + L" kept\n";
+  } //for
+
+  //finalists
+
+  UINT nBest = vSeed[0]; //best seed
+  float fBest = 0.0f; //its score
+  double dMean = 0.0; //its mean
+  float fLand = 0.0f; //its land fraction
+  float fSlope = 0.0f; //its maximum slope
+  size_t nRendered = 0; //number of finalists rendered
+
+  for(const UINT nSeed: vSeed){
+    m_pPerlin->Reseed(nSeed);
+    RenderNoise(m_fNoise, nThreads, m_cStats);
+
+    const float fMax = GetMaxSlope(m_fNoise, w, h); //maximum slope
+    const float fScore = ScoreNoise(m_cStats, fMax); //score
+
+    if(nRendered++ == 0 || fScore < fBest){ //best so far
+      nBest = nSeed;
+      fBest = fScore;
+      dMean = m_cStats.GetMean();
+      fSlope = fMax;
+      fLand = (float)std::count_if(m_fNoise, m_fNoise + (size_t)w*h,
+        [&](float v){return v > m_fSeaLevel;})/(w*h);
+    } //if
+
+    if(fScore <= 1.0f)break; //hit the targets
+  } //for
+
+  m_pPerlin->Reseed(nBest);
+  Invalidate();
+  GenerateNoiseBitmap();
+
+  const auto stop = std::chrono::steady_clock::now(); //stop time
+
+  wstr += L"Full resolution: " + std::to_wstring(nRendered) + L" of ";
+  wstr += std::to_wstring(vSeed.size()) + L" finalists rendered\n\n";
+
+  wstr += L"Seed " + std::to_wstring(nBest);
+  wstr += (fBest <= 1.0f)? L" hits": L" is the closest to";
+  wstr += L" the targets, with mean " + to_wstring_f(dMean, 3) + L", ";
+  wstr += to_wstring_f(100.0f*fLand, 1) + L"% above sea level, ";
+  wstr += L"and maximum slope " + to_wstring_f(fSlope, 3) + L" per pixel.\n";
+
+  wstr += L"Search time " + to_wstring_f(
+    std::chrono::duration<double, std::milli>(stop - start).count(), 0) +
+    L" ms.\n";
+
+  return wstr;
+} //SearchSeeds
+
+#pragma endregion Seed search functions
+
 ///////////////////////////////////////////////////////////////////////////////
 // Reader functions
 
@@ -560,14 +2122,32 @@ const std::wstring CMain::GetFileName() const{
   std::wstring wstr;
 
   switch(m_eNoise){
-    case eNoise::Perlin: wstr = L"Perlin"; break;
-    case eNoise::Value:  wstr = L"Value";  break;
+    case eNoise::Perlin:  wstr = L"Perlin";  break;
+    case eNoise::Value:   wstr = L"Value";   break;
+    case eNoise::Simplex: wstr = L"Simplex"; break;
+    case eNoise::Worley:  wstr = L"Worley";  break;
+  } //switch
+
+  if(m_eNoise == eNoise::Worley)
+    switch(m_pPerlin->GetWorley()){
+      case eWorley::F1:        wstr += L"-F1";   break;
+      case eWorley::F2:        wstr += L"-F2";   break;
+      case eWorley::F2MinusF1: wstr += L"-F2F1"; break;
+    } //switch
+
+  switch(m_pPerlin->GetFractal()){
+    case eFractal::Sum: break; //nothing, which is the default
+    case eFractal::Turbulence: wstr += L"-Turb";   break;
+    case eFractal::Billow:     wstr += L"-Billow"; break;
+    case eFractal::Ridged:     wstr += L"-Ridged"; break;
   } //switch
 
   switch(m_pPerlin->GetHash()){
     case eHash::Permutation:        wstr += L"-Perm"; break;
     case eHash::LinearCongruential: wstr += L"-Lin";  break;
     case eHash::Std:                wstr += L"-Std";  break;
+    case eHash::Stateless:          wstr += L"-Free"; break;
+    case eHash::Coprime:            wstr += L"-Co";   break;
   } //switch
 
   switch(m_pPerlin->GetDistribution()){
@@ -588,10 +2168,38 @@ const std::wstring CMain::GetFileName() const{
   wstr += L"-" + std::to_wstring(m_nOctaves);
   wstr += L"-" + std::to_wstring(m_pPerlin->GetTableSize());
   wstr += L"-" + std::to_wstring((size_t)round(m_fScale));
+  if(m_bFixedPoint)wstr += L"-Fixed";
+  else if(m_bCullOctaves)wstr += L"-Culled";
+  else if(m_bDomainWarp)wstr += L"-Warped";
 
   return wstr;
 } //GetFileName
 
+/// Make up a key for the render cache that encodes the complete state of the
+/// noise generator and the render, that is, everything in the file name
+/// from `GetFileName()` plus the exact scale, origin, animation time, seed,
+/// bitmap size, and format. Floating point numbers are printed in hexadecimal
+/// so that they are exact. The version number `m_nCacheVersion` must be
+/// incremented whenever a change to the code changes the noise, so that
+/// stale renders are never found.
+/// \return Wide string cache key.
+
+const std::wstring CMain::GetCacheKey() const{
+  std::wstring wstr = GetFileName();
+
+  if(m_bCullOctaves)wstr += L"-Cull";
+  if(m_bDomainWarp)wstr += L"-Warp";
+
+  const size_t n = 256; //buffer size
+  wchar_t buffer[n]; //text buffer
+
+  swprintf(buffer, n, L"-%a-%a-%a-%a-%X-%ux%u-f32-v%u", m_fScale,
+    m_dOriginX, m_dOriginY, m_pPerlin->GetTime(), m_pPerlin->GetSeed(),
+    m_pBitmap->GetWidth(), m_pBitmap->GetHeight(), m_nCacheVersion);
+
+  return wstr + buffer;
+} //GetCacheKey
+
 /// Get noise description including type of noise and its parameters.
 /// \return Wide string noise description.
 
@@ -600,7 +2208,7 @@ const std::wstring CMain::GetNoiseDescription() const{
 
   //number of octaves
 
-  if(m_eNoise == eNoise::Perlin || m_eNoise == eNoise::Value){
+  if(m_eNoise != eNoise::None){
     wstr += std::to_wstring(m_nOctaves) + L" octave";
     if(m_nOctaves > 1)wstr += L"s";
     wstr += L" of ";
@@ -609,17 +2217,33 @@ const std::wstring CMain::GetNoiseDescription() const{
   //type of noise
 
   switch(m_eNoise){
-    case eNoise::Perlin: wstr += L"Perlin"; break;
-    case eNoise::Value:  wstr += L"Value";  break;
+    case eNoise::Perlin:  wstr += L"Perlin";  break;
+    case eNoise::Value:   wstr += L"Value";   break;
+    case eNoise::Simplex: wstr += L"Simplex"; break;
+    case eNoise::Worley:  wstr += L"Worley";  break;
   } //switch
 
   wstr += L" Noise";
 
+  if(m_eNoise == eNoise::Worley)
+    switch(m_pPerlin->GetWorley()){
+      case eWorley::F1:        wstr += L" F1";      break;
+      case eWorley::F2:        wstr += L" F2";      break;
+      case eWorley::F2MinusF1: wstr += L" F2 - F1"; break;
+    } //switch
+
+  switch(m_pPerlin->GetFractal()){
+    case eFractal::Sum: break; //nothing, which is the default
+    case eFractal::Turbulence: wstr += L" turbulence"; break;
+    case eFractal::Billow:     wstr += L" billow";     break;
+    case eFractal::Ridged:     wstr += L" ridged multifractal"; break;
+  } //switch
+
   //origin
   
   wstr += L" with origin (";
-  wstr += to_wstring_f(m_fOriginX, 2) + L", ";
-  wstr += to_wstring_f(m_fOriginY, 2) + L"), ";
+  wstr += to_wstring_f(m_dOriginX, 2) + L", ";
+  wstr += to_wstring_f(m_dOriginY, 2) + L"), ";
 
   //hash function
 
@@ -627,6 +2251,8 @@ const std::wstring CMain::GetNoiseDescription() const{
     case eHash::Permutation:         wstr += L"a permutation"; break;
     case eHash::LinearCongruential:  wstr += L"linear congruential"; break;
     case eHash::Std:                 wstr += L"std";  break;
+    case eHash::Stateless:           wstr += L"table-free"; break;
+    case eHash::Coprime:             wstr += L"coprime permutation"; break;
   } //switch
 
   wstr += L" hash function, ";
@@ -643,21 +2269,25 @@ const std::wstring CMain::GetNoiseDescription() const{
   } //switch
 
   switch(m_eNoise){
-    case eNoise::Perlin: wstr += L" gradient"; break;
-    case eNoise::Value:  wstr += L" height";   break;
+    case eNoise::Perlin:
+    case eNoise::Simplex: wstr += L" gradient"; break;
+    case eNoise::Value:   wstr += L" height";   break;
+    case eNoise::Worley:  wstr += L" feature point"; break;
   } //switch
 
   wstr += L" distribution, ";
 
-  //spline function
+  //spline function, which Simplex and Worley noise don't use
 
-  switch(m_pPerlin->GetSpline()){
-    case eSpline::None:    wstr += L"no";      break; 
-    case eSpline::Cubic:   wstr += L"cubic";   break; 
-    case eSpline::Quintic: wstr += L"quintic"; break;
-  } //switch
+  if(m_eNoise != eNoise::Simplex && m_eNoise != eNoise::Worley){
+    switch(m_pPerlin->GetSpline()){
+      case eSpline::None:    wstr += L"no";      break; 
+      case eSpline::Cubic:   wstr += L"cubic";   break; 
+      case eSpline::Quintic: wstr += L"quintic"; break;
+    } //switch
 
-  wstr += L" spline function, ";
+    wstr += L" spline function, ";
+  } //if
 
   //scale
 
@@ -665,26 +2295,58 @@ const std::wstring CMain::GetNoiseDescription() const{
 
   //table size
   
-  if(m_pPerlin->GetHash() == eHash::Permutation)
-    wstr += L"permutation and ";
-
-  switch(m_eNoise){
-    case eNoise::Perlin: wstr += L"gradient "; break;
-    case eNoise::Value:  wstr += L"value ";  break;
-  } //switch
+  if(m_pPerlin->GetHash() == eHash::Stateless)
+    wstr += L"no tables";
+
+  else{
+    if(m_pPerlin->GetHash() == eHash::Permutation)
+      wstr += L"permutation and ";
+
+    switch(m_eNoise){
+      case eNoise::Perlin:
+      case eNoise::Simplex: wstr += L"gradient "; break;
+      case eNoise::Value:   wstr += L"value ";    break;
+      case eNoise::Worley:  wstr += L"feature point "; break;
+    } //switch
       
-  wstr += L"table size ";
-  wstr += std::to_wstring(m_pPerlin->GetTableSize());
+    wstr += L"table size ";
+    wstr += std::to_wstring(m_pPerlin->GetTableSize());
+  } //else
+
+  if(m_pPerlin->GetTime() != 0.0){ //animated
+    wstr += L", animated to time " + to_wstring_f(m_pPerlin->GetTime(), 2);
+
+    if(m_bAnimate){
+      wstr += L" (last frame took " + std::to_wstring(m_dwFrameTime);
+      wstr += L" ms)";
+    } //if
+  } //if
+
+  if(m_bFixedPoint)wstr += L", using fixed-point arithmetic";
+  else if(m_bCullOctaves)wstr += L", culling octaves above Nyquist";
+  else if(m_bDomainWarp)wstr += L", domain warped";
   wstr += L". ";
 
-  //noise max, min, and average
+  //noise max, min, average, moments, and percentiles
 
   wstr += L"Largest generated noise ";
-  wstr += to_wstring_f(m_fMax, 4) + L". ";
+  wstr += to_wstring_f(m_cStats.GetMax(), 4) + L". ";
   wstr += L"Smallest generated noise ";
-  wstr += to_wstring_f(m_fMin, 4) + L". ";
+  wstr += to_wstring_f(m_cStats.GetMin(), 4) + L". ";
   wstr += L"Average generated noise ";
-  wstr += to_wstring_f(m_fAve, 4) + L".";
+  wstr += to_wstring_f(m_cStats.GetMean(), 4) + L". ";
+
+  wstr += L"Standard deviation ";
+  wstr += to_wstring_f(sqrt(m_cStats.GetVariance()), 4) + L", skewness ";
+  wstr += to_wstring_f(m_cStats.GetSkewness(), 4) + L", excess kurtosis ";
+  wstr += to_wstring_f(m_cStats.GetKurtosis(), 4) + L". ";
+
+  wstr += L"Approximate 5th, 25th, 50th, 75th, and 95th percentiles ";
+  wstr += to_wstring_f(m_cStats.GetPercentile(0.05f), 3) + L", ";
+  wstr += to_wstring_f(m_cStats.GetPercentile(0.25f), 3) + L", ";
+  wstr += to_wstring_f(m_cStats.GetPercentile(0.50f), 3) + L", ";
+  wstr += to_wstring_f(m_cStats.GetPercentile(0.75f), 3) + L", and ";
+  wstr += to_wstring_f(m_cStats.GetPercentile(0.95f), 3) + L".";
 
   return wstr;
 } //GetNoiseDescription
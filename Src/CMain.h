@@ -30,6 +30,12 @@
 #include "Windows.h"
 #include "WindowsHelpers.h"
 #include "perlin.h"
+#include "Stats.h"
+#include "Spectrum.h"
+#include "RenderCache.h"
+#include "TileCache.h"
+
+#include <vector>
 
 /// \brief The main class.
 ///
@@ -49,12 +55,14 @@ class CMain{
     HMENU m_hDistMenu   = nullptr; ///< Handle to the `Distribution` menu.
     HMENU m_hHashMenu   = nullptr; ///< Handle to the `Hash` menu.
     HMENU m_hSplineMenu = nullptr; ///< Handle to the `Spline` menu.
+    HMENU m_hWorleyMenu = nullptr; ///< Handle to the `Worley` menu.
+    HMENU m_hFractalMenu = nullptr; ///< Handle to the `Fractal` menu.
     HMENU m_hOctaveMenu = nullptr; ///< Handle to the `Octave` menu.
     
     eNoise m_eNoise = eNoise::None; ///< Noise type.
 
-    float m_fOriginX = 0.0f; ///< X-coordinate of top.
-    float m_fOriginY = 0.0f; ///< Y-coordinate of left.
+    double m_dOriginX = 0.0; ///< X-coordinate of top.
+    double m_dOriginY = 0.0; ///< Y-coordinate of left.
     
     const size_t m_nDefOctaves = 4; ///< Default number of octaves of noise.
     size_t m_nOctaves = m_nDefOctaves; ///< Number of octaves of noise.
@@ -66,17 +74,55 @@ class CMain{
     const float m_fMinScale = 8.0f; ///< Minimum scale.
     const float m_fMaxScale = 512.0f; ///< Minimum scale.
 
-    float m_fMin = 0.0f; ///< Smallest noise value in generated noise.
-    float m_fMax = 0.0f; ///< Largest noise value in generated noise.
-    float m_fAve = 0.0f; ///< Average noise value in generated noise.
+    const size_t m_nWarpLevels = 2; ///< Number of levels of domain warp.
+    const size_t m_nWarpOctaves[2] = {2, 4}; ///< Octaves of warp field at each level, innermost first.
+    const float m_fWarpStrength = 2.0f; ///< Domain warp strength.
+
+    const float m_fAnimSpeed = 0.25f; ///< Animation time units per second.
+    const UINT m_nFrameBudget = 16; ///< Frame time budget in milliseconds.
+    const UINT_PTR m_nAnimTimer = 1; ///< Animation timer id.
+    const UINT m_nExportWidth = 1920; ///< Width of exported animation frames.
+    const UINT m_nExportHeight = 1080; ///< Height of exported animation frames.
+    const UINT m_nExportFrames = 120; ///< Number of exported animation frames.
+    DWORD m_dwAnimStart = 0; ///< Time at which animation time was zero.
+    DWORD m_dwFrameTime = 0; ///< Time taken to render the last frame.
+
+    CNoiseStats m_cStats; ///< Statistics of generated noise.
+    const UINT m_nTileRows = 16; ///< Rows of pixels per statistics tile.
+    const size_t m_nSpectrumSize = 256; ///< Width of spectrum analysis tiles.
+    const size_t m_nSpectrumTiles = 16; ///< Number of spectrum analysis tiles.
+    const float m_fGoldenTolerance = 1.0e-5f; ///< Golden image error tolerance.
+    const size_t m_nFuzzCases = 1000; ///< Number of fuzzer test cases per path.
+    const size_t m_nPatchSize = 256; ///< Width and height of benchmark patches.
+    const size_t m_nPatchCount = 64; ///< Number of benchmark patches.
+    const size_t m_nSearchSeeds = 256; ///< Number of candidate seeds in a seed search.
+    const size_t m_nSearchLevels = 3; ///< Number of proxy resolutions in a seed search.
+    const size_t m_nSearchKeep = 4; ///< One in this many candidates is kept at each proxy resolution.
+    const float m_fTargetMean = 0.0f; ///< Seed search target mean.
+    const float m_fTargetLand = 0.45f; ///< Seed search target fraction of values above sea level.
+    const float m_fSeaLevel = 0.0f; ///< Seed search sea level.
+    const float m_fTargetSlope = 0.045f; ///< Seed search maximum slope per pixel.
+    const float m_fSearchTolerance = 0.02f; ///< Seed search tolerance for mean and sea level.
+    const uint64_t m_nCacheBudget = 2ULL << 30; ///< Render cache size budget in bytes.
+    const UINT m_nCacheVersion = 1; ///< Render cache version, incremented when the noise changes.
+    const size_t m_nCacheTileSize = 128; ///< Width and height of tile cache tiles in pixels.
+    const size_t m_nTileBudget = 256 << 20; ///< Tile cache memory budget in bytes.
+    uint64_t m_nVersion = 0; ///< Parameter version, incremented when the noise changes.
 
     ULONG_PTR m_gdiplusToken = 0; ///< GDI+ token.
 
     Gdiplus::Bitmap* m_pBitmap = nullptr; ///< Pointer to a bitmap image.
+    float* m_fNoise = nullptr; ///< Noise value for each pixel, row-major.
     CPerlinNoise2D* m_pPerlin = nullptr; ///< Pointer to Perlin noise generator.
+    CRenderCache* m_pCache = nullptr; ///< Pointer to render cache.
+    CTileCache* m_pTiles = nullptr; ///< Pointer to tile cache.
 
     bool m_bShowCoords = false; ///< Show coordinates flag.
     bool m_bShowGrid = false; ///< Show grid flag.
+    bool m_bFixedPoint = false; ///< Use fixed-point arithmetic flag.
+    bool m_bCullOctaves = false; ///< Cull octaves above Nyquist flag.
+    bool m_bDomainWarp = false; ///< Domain warp flag.
+    bool m_bAnimate = false; ///< Animation flag.
 
     void CreateMenus(); ///< Create menus.
     void UpdateMenus(); ///< Update menus.
@@ -85,10 +131,42 @@ class CMain{
     void SetPixel(UINT, UINT, BYTE); ///< Set pixel grayscale from byte.
     void SetPixel(UINT, UINT, Gdiplus::Color); ///< Set pixel from GDI+ color.
     
+    const Gdiplus::Rect GetDestRect() const; ///< Get bitmap rectangle in window.
+
+    void DrawNoise(); ///< Draw noise to bitmap.
     void DrawCoords(); ///< Draw coordinates to bitmap.
     void DrawGrid(); ///< Draw grid to bitmap.
 
     void GenerateNoiseBitmap(Gdiplus::PointF, Gdiplus::RectF); ///< Generate bitmap rectangle.
+    void GenerateNoise(bool, bool); ///< Generate noise, perhaps from the caches.
+    const float GetNoise(double, double) const; ///< Get noise at a point.
+    void GetNoiseRow(double, double, UINT, float*) const; ///< Get a row of noise.
+    void GetNoisePoints(const double*, const double*, UINT, float*) const; ///< Get noise at points.
+    void RenderNoise(float*, UINT, CNoiseStats&) const; ///< Generate noise using threads.
+    void GetNoiseTiles(float*, UINT, UINT, CNoiseStats*) const; ///< Get every n-th tile of noise.
+    void GatherStats(const float*, CNoiseStats&) const; ///< Gather statistics of noise.
+
+    void Invalidate(); ///< Invalidate the tile cache.
+    void GetViewTiles(std::vector<TileKey>&, int64_t&, int64_t&) const; ///< Get tiles in view.
+    const bool HasTiles(bool) const; ///< Check for tiles in view.
+    void RenderTiles(float*, UINT); ///< Generate noise from tiles.
+    void PutTiles(const float*); ///< Put tiles in view into the tile cache.
+    void GetCacheTile(const TileKey&, float*) const; ///< Get noise for a tile.
+    void GetCacheTiles(const std::vector<TileKey>&, float*, UINT, UINT) const; ///< Get every n-th tile.
+    void CopyTile(const TileKey&, const float*, int64_t, int64_t, float*) const; ///< Copy tile into view.
+
+    void RandomPoints(double*, double*, size_t) const; ///< Make benchmark points.
+    const double TimeNoise(const CPerlinNoise2D&, eNoise) const; ///< Time noise generation.
+    void TimeFusedNoise(const eDistribution*, size_t, eNoise, double&, double&,
+      size_t&) const; ///< Time fused noise generation.
+    void TimePatches(eNoise, double&, double&, size_t&) const; ///< Time patch generation.
+    const double CorrelateNoise(const CPerlinNoise2D&, eNoise, double) const; ///< Correlate shifted noise.
+    void AnalyzeSpectrum(const CPerlinNoise2D&, eNoise, CSpectrum&) const; ///< Power spectrum of noise.
+    const std::wstring DescribeSpectrum(const CSpectrum&, const CSpectrum&) const; ///< Spectrum summary.
+
+    const float GetMaxSlope(const float*, size_t, size_t) const; ///< Maximum slope of noise.
+    const float ScoreNoise(const CNoiseStats&, float) const; ///< Score noise against targets.
+    const size_t ScoreProxies(std::vector<UINT>&, UINT) const; ///< Score and cull candidate seeds.
 
   public:
     CMain(const HWND hwnd); ///< Constructor.
@@ -98,25 +176,38 @@ class CMain{
     void ClearBitmap(Gdiplus::Color); ///< Clear bitmap to color.
 
     void Randomize(); ///< Randomize PRNG.
+    const bool CanSearchSeeds() const; ///< Whether seed search is available.
+    const std::wstring SearchSeeds(); ///< Search for a seed that hits targets.
 
-    void GenerateNoiseBitmap(eNoise); ///< Generate Perlin or Value noise bitmap.
+    void GenerateNoiseBitmap(eNoise); ///< Generate noise bitmap.
     void GenerateNoiseBitmap(); ///< Generate bitmap again with saved parameters.
 
     bool SetDistribution(eDistribution); ///< Set probability distribution.
     void SetSpline(eSpline); ///< Set spline function.
+    void SetWorley(eWorley); ///< Set Worley noise distance.
+    void SetFractal(eFractal); ///< Set octave combination.
     void SetHash(eHash); ///< Set hash function.
 
     void ToggleViewCoords(); ///< Toggle View Coordinates flag.
     void ToggleViewGrid(); ///< Toggle View Grid flag.
+    void ToggleFixedPoint(); ///< Toggle Fixed-Point Arithmetic flag.
+    void ToggleCullOctaves(); ///< Toggle Cull Octaves flag.
+    void ToggleDomainWarp(); ///< Toggle Domain Warp flag.
+    void ToggleAnimation(); ///< Toggle Animate flag.
+    void NextFrame(); ///< Draw the next frame of animation.
+    const std::wstring ExportAnimation(const std::wstring&); ///< Export numbered frames.
 
     void Jump(); ///< Change origin coordinates.
-    void Jump(float x, float y); ///< Change origin coordinates.
-    const bool Origin(float x, float y) const; ///< Check origin coordinates.
+    void Jump(double x, double y); ///< Change origin coordinates.
+    const bool Origin(double x, double y) const; ///< Check origin coordinates.
 
     void IncreaseOctaves(); ///< Increase number of octaves.
     void DecreaseOctaves(); ///< Decrease number of octaves.
     void IncreaseScale(); ///< Increase scale.
     void DecreaseScale(); ///< Decrease scale.
+    bool Zoom(bool, int, int); ///< Zoom about a pixel.
+    void GetZoomTiles(float*, bool, int, int, UINT, UINT) const; ///< Get every n-th tile of zoomed noise.
+    bool ZoomClient(bool, int, int); ///< Zoom about a point in the window.
     void IncreaseTableSize(); ///< Increase table size.
     void DecreaseTableSize(); ///< Decrease table size.
     void Reset(); ///< Reset number of octaves, scale, table size.
@@ -125,7 +216,13 @@ class CMain{
 
     Gdiplus::Bitmap* GetBitmap() const; ///< Get pointer to bitmap.
     const std::wstring GetFileName() const; ///< Get noise file name.
+    const std::wstring GetCacheKey() const; ///< Get render cache key.
     const std::wstring GetNoiseDescription() const; ///< Get noise description.
+
+    const std::wstring Benchmark() const; ///< Run benchmarks.
+    const std::wstring SaveGolden(const std::wstring&) const; ///< Save golden images.
+    const std::wstring CheckGolden(const std::wstring&) const; ///< Check golden images.
+    const std::wstring Fuzz() const; ///< Fuzz fast paths.
 }; //CMain
 
 #endif //__CMAIN_H__
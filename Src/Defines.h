@@ -30,21 +30,39 @@
 #include <math.h>
 
 const float PI = (float)M_PI; ///< Pi.
+const double F2 = 0.36602540378443865; ///< Simplex skew factor, \f$(\sqrt{3} - 1)/2\f$.
+const float G2 = 0.21132487f; ///< Simplex unskew factor, \f$(3 - \sqrt{3})/6\f$.
+const float JITTER = 0.3f; ///< Max offset of a Worley feature point from its cell center.
 
 /// \brief Perlin noise type.
 ///
-/// Enumerated type for Perlin noise.
+/// Enumerated type for Perlin noise. `Simplex` sums gradients over the three
+/// corners of a triangle instead of interpolating over the four corners of
+/// a square. `Worley` is cellular noise made from the distances to
+/// randomly placed feature points.
 
 enum class eNoise{
-  None, Perlin, Value
+  None, Perlin, Value, Simplex, Worley
 }; //eNoise
 
+/// \brief Worley noise type.
+///
+/// Enumerated type for the distance used in Worley noise, which is the
+/// distance to the nearest feature point (`F1`), the distance to the second
+/// nearest feature point (`F2`), or the difference between them (`F2MinusF1`).
+
+enum class eWorley{
+  F1, F2, F2MinusF1
+}; //eWorley
+
 /// \brief Hash function type.
 ///
-/// Enumerated type for hash function.
+/// Enumerated type for hash function. `Stateless` hashes lattice points
+/// straight to gradients or values without using any tables. `Coprime`
+/// combines three small permutations whose sizes are coprime.
 
 enum class eHash{
-  Permutation, LinearCongruential, Std
+  Permutation, LinearCongruential, Std, Stateless, Coprime
 }; //eHash
 
 /// \brief Distribution.
@@ -63,4 +81,24 @@ enum class eSpline{
   None, Cubic, Quintic
 }; //eSpline
 
+/// \brief Fractal type.
+///
+/// Enumerated type for the way that octaves are combined. `Sum` adds them
+/// up as they are. `Turbulence` adds their absolute values, `Billow` adds
+/// their absolute values scaled into \f$[-1, 1]\f$, and `Ridged` is
+/// Musgrave's ridged multifractal, in which each octave is inverted,
+/// squared, and weighted by the octave before it.
+
+enum class eFractal{
+  Sum, Turbulence, Billow, Ridged
+}; //eFractal
+
+/// \brief Instruction set.
+///
+/// Enumerated type for the instruction set used by the batch noise kernels.
+
+enum class eISA{
+  Scalar, SSE2, AVX2, AVX512
+}; //eISA
+
 #endif //__DEFINES_H__
@@ -0,0 +1,609 @@
+/// \file Fuzz.cpp
+///
+/// \brief Code for the differential fuzzer.
+
+// MIT License
+//
+// Copyright (c) 2022 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+#include <cwchar>
+
+#include "Fuzz.h"
+#include "Kernels.h"
+
+/// Seed the PRNG for test cases.
+/// \param seed PRNG seed, which is reported so that a run can be repeated.
+
+CFuzzer::CFuzzer(uint64_t seed): m_cRandom(seed), m_nSeed(seed){
+} //constructor
+
+/// Get a random coordinate of one of several kinds that are likely to
+/// expose differences between evaluation paths.
+/// \param nTableSize Table size, for points at multiples of it.
+/// \return A coordinate.
+
+const double CFuzzer::RandomCoordinate(size_t nTableSize){
+  std::uniform_real_distribution<double> unit(0.0, 1.0); //in [0, 1)
+  std::uniform_int_distribution<int> sign(0, 1); //0 or 1
+  const double s = sign(m_cRandom)? -1.0: 1.0; //random sign
+  const double tiny[] = {0.0, DBL_EPSILON, -DBL_EPSILON, 0.5,
+    1.0 - FLT_EPSILON/2, FLT_EPSILON/2, DBL_TRUE_MIN, -DBL_TRUE_MIN};
+  const size_t nTiny = sizeof(tiny)/sizeof(double); //number of tiny offsets
+
+  switch(std::uniform_int_distribution<int>(0, 5)(m_cRandom)){
+    case 0: //ordinary
+      return s*16.0*unit(m_cRandom);
+
+    case 1: //large
+      return s*1.0e9*unit(m_cRandom);
+
+    case 2: //huge, but small enough for 8 octaves of 64-bit lattice cells
+      return s*ldexp(1.0 + unit(m_cRandom),
+        std::uniform_int_distribution<int>(30, 50)(m_cRandom));
+
+    case 3: { //on or next to a cell boundary
+      const double k = (double)std::uniform_int_distribution<int>(-1000,
+        1000)(m_cRandom); //cell
+      return k + tiny[std::uniform_int_distribution<size_t>(0, nTiny - 1)(
+        m_cRandom)];
+    } //case
+
+    case 4: { //on or next to a multiple of the table size
+      const double k = (double)std::uniform_int_distribution<int>(-4, 4)(
+        m_cRandom)*nTableSize; //multiple of table size
+      return k + tiny[std::uniform_int_distribution<size_t>(0, nTiny - 1)(
+        m_cRandom)];
+    } //case
+
+    default: { //next to zero and the denormals
+      const double d[] = {0.0, -0.0, DBL_TRUE_MIN, 1.0e-310, DBL_MIN,
+        FLT_TRUE_MIN, FLT_MIN, FLT_MIN/2, FLT_EPSILON}; //small values
+      return s*d[std::uniform_int_distribution<size_t>(0,
+        sizeof(d)/sizeof(double) - 1)(m_cRandom)];
+    } //default
+  } //switch
+} //RandomCoordinate
+
+/// Make a test case with random settings for an evaluation path. The batch
+/// kernels are only used with the permutation hash and a persistence of 2,
+/// so those are chosen most of the time. Fixed-point noise is Perlin or Value
+/// noise only, with a persistence of 2, a lacunarity in Q16, and
+/// coordinates that are multiples of \f$2^{-16}\f$.
+/// \param path Evaluation path.
+/// \param isa Instruction set for the batch and warp paths.
+/// \return Test case with coordinates of zero.
+
+const FuzzCase CFuzzer::RandomCase(eFuzzPath path, eISA isa){
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f); //in [0, 1)
+  auto pick = [&](int n){ //random integer in [0, n)
+    return std::uniform_int_distribution<int>(0, n - 1)(m_cRandom);};
+
+  const eNoise noise[] = {eNoise::Perlin, eNoise::Value, eNoise::Simplex,
+    eNoise::Worley}; //noise types
+  const eHash hash[] = {eHash::Permutation, eHash::LinearCongruential,
+    eHash::Std, eHash::Stateless, eHash::Coprime}; //hash functions
+  const eDistribution dist[] = {eDistribution::Uniform, eDistribution::Cosine,
+    eDistribution::Normal, eDistribution::Exponential,
+    eDistribution::Midpoint, eDistribution::Maximal}; //distributions
+
+  FuzzCase c; //result
+  const bool bFixed = path == eFuzzPath::Fixed; //fixed-point
+
+  c.ePath = path;
+  c.eISAType = isa;
+  c.eNoiseType = noise[pick(bFixed? 2: 4)];
+  c.eHashType = (pick(4) > 0)? eHash::Permutation: hash[pick(5)];
+  c.eSplineType = (eSpline)pick(3);
+  c.eDistType = dist[pick(6)];
+  c.eFractalType = (eFractal)pick(4);
+  c.eWorleyType = (eWorley)pick(3);
+  c.nTableSize = (size_t)1 << (4 + pick(13));
+  c.nOctaves = 1 + pick(8);
+  c.fAlpha = (pick(2) == 0)? 0.5f: 0.2f + 0.6f*unit(m_cRandom);
+  c.fBeta = (bFixed || pick(8) > 0)? 2.0f: 1.5f + 1.5f*unit(m_cRandom);
+  c.fFootprint = exp2f(-8.0f*unit(m_cRandom));
+  c.nWarpOctaves[0] = pick(5);
+  c.nWarpOctaves[1] = pick(5);
+  c.fWarpStrength = 4.0f*unit(m_cRandom);
+  c.nSeed = (UINT)m_cRandom();
+
+  if(bFixed)
+    c.fAlpha = (float)(int32_t)(c.fAlpha*65536.0f)/65536.0f; //Q16
+
+  return c;
+} //RandomCase
+
+/// Set up a noise generator for a test case.
+/// \param perlin [IN, OUT] Noise generator.
+/// \param c Test case.
+
+void CFuzzer::Configure(CPerlinNoise2D& perlin, const FuzzCase& c){
+  while(perlin.GetTableSize() > c.nTableSize && perlin.HalveTableSize());
+  while(perlin.GetTableSize() < c.nTableSize && perlin.DoubleTableSize());
+
+  perlin.SetHash(c.eHashType);
+  perlin.SetSpline(c.eSplineType);
+  perlin.SetFractal(c.eFractalType);
+  perlin.SetWorley(c.eWorleyType);
+  perlin.SetTime(0.0);
+  perlin.RandomizeTable(c.eDistType);
+  perlin.Reseed(c.nSeed);
+  perlin.SetISA(c.eISAType);
+} //Configure
+
+/// Evaluate noise at a batch of points with the same settings by the
+/// reference and by the fast path. The fused path fuses this generator with
+/// generators for the next probability distributions, except for the last,
+/// which has the next seed and so a different lattice. The value for each
+/// point is from the first generator that mismatches, if any. The patch
+/// path generates a single pixel patch at each point.
+/// \param point Test cases, all the same except for their coordinates.
+/// \param ref [OUT] Reference noise values.
+/// \param fast [OUT] Noise values from the fast path.
+
+void CFuzzer::Evaluate(const std::vector<FuzzCase>& point,
+  std::vector<float>& ref, std::vector<float>& fast)
+{
+  const FuzzCase& c = point[0]; //settings
+  const size_t n = point.size(); //number of points
+
+  std::vector<double> x(n), y(n); //coordinates
+  ref.resize(n);
+  fast.resize(n);
+
+  for(size_t i=0; i<n; i++){
+    x[i] = point[i].dX;
+    y[i] = point[i].dY;
+  } //for
+
+  Configure(m_cPerlin, c);
+
+  switch(c.ePath){
+    case eFuzzPath::Batch:
+      m_cPerlin.generatebatch(x.data(), y.data(), n, fast.data(),
+        c.eNoiseType, c.nOctaves, c.fAlpha, c.fBeta);
+
+      for(size_t i=0; i<n; i++)
+        ref[i] = m_cPerlin.generate(x[i], y[i], c.eNoiseType, c.nOctaves,
+          c.fAlpha, c.fBeta);
+    break;
+
+    case eFuzzPath::Warp:
+      m_cPerlin.generatewarp(x.data(), y.data(), n, fast.data(),
+        c.eNoiseType, c.nOctaves, c.nWarpOctaves, 2, c.fWarpStrength,
+        c.fAlpha, c.fBeta);
+
+      m_cPerlin.SetISA(eISA::Scalar);
+      m_cPerlin.generatewarp(x.data(), y.data(), n, ref.data(),
+        c.eNoiseType, c.nOctaves, c.nWarpOctaves, 2, c.fWarpStrength,
+        c.fAlpha, c.fBeta);
+    break;
+
+    case eFuzzPath::Pyramid:
+      for(size_t i=0; i<n; i++){
+        float* level = &fast[i]; //a single sample
+        m_cPerlin.generatepyramid(&level, 1, 1, 1, x[i], y[i], c.fFootprint,
+          c.eNoiseType, c.nOctaves, c.fAlpha, c.fBeta);
+        ref[i] = m_cPerlin.generate(x[i], y[i], c.fFootprint, c.eNoiseType,
+          c.nOctaves, c.fAlpha, c.fBeta);
+      } //for
+    break;
+
+    case eFuzzPath::Fixed:
+      for(size_t i=0; i<n; i++){
+        fast[i] = m_cPerlin.generatefixed((int64_t)(x[i]*65536.0),
+          (int64_t)(y[i]*65536.0), c.eNoiseType, c.nOctaves,
+          (int32_t)(c.fAlpha*65536.0f))/32768.0f;
+        ref[i] = m_cPerlin.generate(x[i], y[i], c.eNoiseType, c.nOctaves,
+          c.fAlpha, c.fBeta);
+      } //for
+    break;
+
+    case eFuzzPath::Fused: {
+      std::vector<CPerlinNoise2D> other(m_nFused - 1); //other generators
+      std::vector<const CPerlinNoise2D*> gen(1, &m_cPerlin); //all generators
+      std::vector<float> v(m_nFused*n); //noise values
+      std::vector<float*> r(m_nFused); //noise values for each generator
+
+      for(size_t k=1; k<m_nFused; k++){
+        FuzzCase d = c; //settings for generator k
+        d.eDistType = (eDistribution)(((size_t)c.eDistType + k)%6);
+        if(k == m_nFused - 1)d.nSeed++; //different lattice, not fused
+
+        Configure(other[k - 1], d);
+        gen.push_back(&other[k - 1]);
+      } //for
+
+      for(size_t k=0; k<m_nFused; k++)
+        r[k] = &v[k*n];
+
+      m_cPerlin.generatefused(x.data(), y.data(), n, gen.data(), m_nFused,
+        r.data(), c.eNoiseType, c.nOctaves, c.fAlpha, c.fBeta);
+
+      for(size_t i=0; i<n; i++)
+        for(size_t k=0; k<m_nFused; k++){
+          const float f = gen[k]->generate(x[i], y[i], c.eNoiseType,
+            c.nOctaves, c.fAlpha, c.fBeta); //reference for generator k
+
+          if(k == 0 || (!Mismatch(c, ref[i], fast[i]) &&
+            Mismatch(c, f, r[k][i])))
+          {
+            ref[i] = f;
+            fast[i] = r[k][i];
+          } //if
+        } //for
+    } //case
+    break;
+
+    case eFuzzPath::Patches:
+      for(size_t i=0; i<n; i++){
+        PatchRegion r; //single pixel patch
+        r.dX = x[i];
+        r.dY = y[i];
+        r.nWidth = r.nHeight = 1;
+
+        m_cPerlin.generatepatches(&c.nSeed, 1, r, &fast[i], c.eNoiseType,
+          c.nOctaves, c.fAlpha, c.fBeta, 1);
+        ref[i] = m_cPerlin.generate(x[i], y[i], c.eNoiseType, c.nOctaves,
+          c.fAlpha, c.fBeta);
+      } //for
+    break;
+  } //switch
+} //Evaluate
+
+/// Evaluate a pyramid of noise images by the reference and by
+/// `generatepyramid()`. Each sample of each level is compared with
+/// band-limited noise at the same point for that level's sample spacing.
+/// \param c Test case, with the coordinates of the first sample.
+/// \param point [OUT] A test case for each sample of each level.
+/// \param ref [OUT] Reference noise values.
+/// \param fast [OUT] Noise values from `generatepyramid()`.
+
+void CFuzzer::EvaluatePyramid(const FuzzCase& c, std::vector<FuzzCase>& point,
+  std::vector<float>& ref, std::vector<float>& fast)
+{
+  const size_t w = m_nPyramidSize; //width of level 0
+
+  std::vector<std::vector<float>> image(m_nPyramidLevels); //levels
+  std::vector<float*> level(m_nPyramidLevels); //pointers to levels
+
+  for(size_t k=0; k<m_nPyramidLevels; k++){
+    image[k].resize((w >> k)*(w >> k));
+    level[k] = image[k].data();
+  } //for
+
+  Configure(m_cPerlin, c);
+  m_cPerlin.generatepyramid(level.data(), w, w, m_nPyramidLevels, c.dX, c.dY,
+    c.fFootprint, c.eNoiseType, c.nOctaves, c.fAlpha, c.fBeta);
+
+  point.clear();
+  ref.clear();
+  fast.clear();
+
+  for(size_t k=0; k<m_nPyramidLevels; k++) //for each level
+    for(size_t i=0; i<(w >> k); i++)
+      for(size_t j=0; j<(w >> k); j++){
+        FuzzCase d = c; //single point
+        d.dX = c.dX + (j << k)*(double)c.fFootprint;
+        d.dY = c.dY + (i << k)*(double)c.fFootprint;
+        d.fFootprint = c.fFootprint*(float)(1 << k);
+
+        point.push_back(d);
+        fast.push_back(image[k][i*(w >> k) + j]);
+        ref.push_back(m_cPerlin.generate(d.dX, d.dY, d.fFootprint,
+          c.eNoiseType, c.nOctaves, c.fAlpha, c.fBeta));
+      } //for
+} //EvaluatePyramid
+
+/// Evaluate patches of noise for consecutive seeds by the reference and by
+/// `generatepatches()` on more than one thread. The patches cover a square
+/// of `m_nPatchSize` pixels with a sample spacing of the test case's
+/// footprint. Each pixel of each patch is compared with noise from a
+/// generator seeded with that patch's seed.
+/// \param c Test case, with the coordinates of the top-left pixel and the
+/// first seed.
+/// \param point [OUT] A test case for each pixel of each patch.
+/// \param ref [OUT] Reference noise values.
+/// \param fast [OUT] Noise values from `generatepatches()`.
+
+void CFuzzer::EvaluatePatches(const FuzzCase& c, std::vector<FuzzCase>& point,
+  std::vector<float>& ref, std::vector<float>& fast)
+{
+  const size_t w = m_nPatchSize; //width and height of patches
+
+  PatchRegion r; //region covered by each patch
+  r.dX = c.dX;
+  r.dY = c.dY;
+  r.fScale = 1.0f/c.fFootprint;
+  r.nWidth = r.nHeight = w;
+
+  std::vector<UINT> seed(m_nPatches); //seeds
+  for(size_t k=0; k<m_nPatches; k++)seed[k] = c.nSeed + (UINT)k;
+
+  std::vector<float> image(m_nPatches*w*w); //patches
+
+  Configure(m_cPerlin, c);
+  m_cPerlin.generatepatches(seed.data(), m_nPatches, r, image.data(),
+    c.eNoiseType, c.nOctaves, c.fAlpha, c.fBeta, 2);
+
+  point.clear();
+  ref.clear();
+  fast.clear();
+
+  for(size_t k=0; k<m_nPatches; k++){ //for each patch
+    FuzzCase d = c; //single point
+    d.nSeed = seed[k];
+    Configure(m_cPerlin, d);
+
+    for(size_t i=0; i<w; i++)
+      for(size_t j=0; j<w; j++){
+        d.dX = r.dX + j/(double)r.fScale;
+        d.dY = r.dY + i/(double)r.fScale;
+
+        point.push_back(d);
+        fast.push_back(image[(k*w + i)*w + j]);
+        ref.push_back(m_cPerlin.generate(d.dX, d.dY, c.eNoiseType,
+          c.nOctaves, c.fAlpha, c.fBeta));
+      } //for
+  } //for
+} //EvaluatePatches
+
+/// Compare a reference noise value with one from a fast path. Fixed-point
+/// noise must be within `m_fFixedTolerance` of the reference clamped to
+/// \f$[-1, 1]\f$, since fixed-point noise saturates there and floating point
+/// noise can overshoot slightly with some distributions. The others must
+/// have exactly the same bits.
+/// \param c Test case.
+/// \param ref Reference noise value.
+/// \param fast Noise value from the fast path.
+/// \return true if they don't match.
+
+const bool CFuzzer::Mismatch(const FuzzCase& c, float ref, float fast) const{
+  if(c.ePath == eFuzzPath::Fixed)
+    return !(fabsf(std::max<float>(-1.0f, std::min<float>(ref, 1.0f)) - fast) <=
+      m_fFixedTolerance); //true for NaN
+
+  return memcmp(&ref, &fast, sizeof(float)) != 0;
+} //Mismatch
+
+/// Test whether the fast path fails at a single point.
+/// \param c Test case.
+/// \return true if it fails.
+
+const bool CFuzzer::Fails(const FuzzCase& c){
+  std::vector<float> ref, fast; //noise values
+  Evaluate(std::vector<FuzzCase>(1, c), ref, fast);
+  return Mismatch(c, ref[0], fast[0]);
+} //Fails
+
+/// Replace a failing test case by a simpler one if that fails too.
+/// \param c [IN, OUT] Failing test case.
+/// \param d Simpler test case.
+/// \return true if the simpler one fails and has replaced the other.
+
+const bool CFuzzer::Try(FuzzCase& c, const FuzzCase& d){
+  const bool bSame = c.eHashType == d.eHashType &&
+    c.eSplineType == d.eSplineType && c.eDistType == d.eDistType &&
+    c.eFractalType == d.eFractalType && c.eWorleyType == d.eWorleyType &&
+    c.nTableSize == d.nTableSize && c.nOctaves == d.nOctaves &&
+    c.fAlpha == d.fAlpha && c.fBeta == d.fBeta &&
+    c.nWarpOctaves[0] == d.nWarpOctaves[0] && c.nSeed == d.nSeed &&
+    memcmp(&c.dX, &d.dX, sizeof(double)) == 0 &&
+    memcmp(&c.dY, &d.dY, sizeof(double)) == 0; //nothing simpler
+
+  if(bSame || !Fails(d))return false;
+
+  c = d;
+  return true;
+} //Try
+
+/// Minimize a failing test case by repeatedly trying fewer octaves, default
+/// settings, and simpler coordinates until none of them fails. A coordinate
+/// is simplified by trying zero, then smaller magnitudes that keep its low
+/// bits, then fewer bits after the binary point.
+/// \param c [IN, OUT] Failing test case.
+
+void CFuzzer::Minimize(FuzzCase& c){
+  bool bChanged = true; //whether the last pass made any progress
+
+  while(bChanged){
+    bChanged = false;
+
+    for(size_t n=1; n<c.nOctaves && !bChanged; n++){ //fewer octaves
+      FuzzCase d = c; d.nOctaves = n;
+      bChanged = Try(c, d);
+    } //for
+
+    const FuzzCase def; //default settings
+    FuzzCase d = c; //simpler case
+
+    d = c; d.eHashType = def.eHashType; bChanged |= Try(c, d);
+    d = c; d.eSplineType = def.eSplineType; bChanged |= Try(c, d);
+    d = c; d.eDistType = def.eDistType; bChanged |= Try(c, d);
+    d = c; d.eFractalType = def.eFractalType; bChanged |= Try(c, d);
+    d = c; d.eWorleyType = def.eWorleyType; bChanged |= Try(c, d);
+    d = c; d.nTableSize = def.nTableSize; bChanged |= Try(c, d);
+    d = c; d.fAlpha = def.fAlpha; bChanged |= Try(c, d);
+    d = c; d.fBeta = def.fBeta; bChanged |= Try(c, d);
+    d = c; d.nWarpOctaves[0] = 0; bChanged |= Try(c, d);
+    d = c; d.nSeed = def.nSeed; bChanged |= Try(c, d);
+
+    for(int axis=0; axis<2; axis++){ //for each coordinate
+      double& u = axis? c.dY: c.dX; //coordinate in c
+      double& v = axis? d.dY: d.dX; //coordinate in d
+      bool bDone = false; //whether a simpler coordinate was found
+
+      d = c; v = 0.0;
+      bDone = Try(c, d);
+
+      for(int m=0; m<63 && !bDone; m++){ //smaller magnitude
+        d = c; v = fmod(u, ldexp(1.0, m));
+        bDone = Try(c, d);
+      } //for
+
+      for(int m=0; m<53 && !bDone; m++){ //fewer bits after the binary point
+        d = c; v = ldexp(round(ldexp(u, m)), -m);
+        bDone = Try(c, d);
+      } //for
+
+      bChanged |= bDone;
+    } //for
+  } //while
+} //Minimize
+
+/// Describe a test case as a reproducer. Floating point numbers are given in
+/// hexadecimal so that they are exact.
+/// \param c Test case.
+/// \return Wide string description.
+
+const std::wstring CFuzzer::Describe(const FuzzCase& c){
+  const wchar_t* noise[] = {L"None", L"Perlin", L"Value", L"Simplex",
+    L"Worley"};
+  const wchar_t* hash[] = {L"permutation", L"linear congruential",
+    L"std::hash", L"table-free", L"coprime"};
+  const wchar_t* spline[] = {L"no spline", L"cubic", L"quintic"};
+  const wchar_t* dist[] = {L"uniform", L"maximal", L"cosine", L"normal",
+    L"exponential", L"midpoint"};
+  const wchar_t* fractal[] = {L"sum", L"turbulence", L"billow", L"ridged"};
+  const wchar_t* worley[] = {L"F1", L"F2", L"F2-F1"};
+
+  std::vector<float> ref, fast; //noise values
+  Evaluate(std::vector<FuzzCase>(1, c), ref, fast);
+
+  wchar_t buf[1024]; //for the result
+  swprintf(buf, sizeof(buf)/sizeof(wchar_t),
+    L"%ls, %ls, %ls, %ls, %ls, %ls, table %zu, seed 0x%X, %zu octaves, "
+    L"alpha %a, beta %a, footprint %a, warp %zu/%zu octaves strength %a, "
+    L"x %a (%.17g), y %a (%.17g): reference %a, fast %a",
+    noise[(int)c.eNoiseType], hash[(int)c.eHashType],
+    spline[(int)c.eSplineType], dist[(int)c.eDistType],
+    fractal[(int)c.eFractalType], worley[(int)c.eWorleyType], c.nTableSize,
+    c.nSeed, c.nOctaves, c.fAlpha, c.fBeta, c.fFootprint, c.nWarpOctaves[0],
+    c.nWarpOctaves[1], c.fWarpStrength, c.dX, c.dX, c.dY, c.dY, ref[0],
+    fast[0]);
+
+  return buf;
+} //Describe
+
+/// Run the fuzzer. For each test case, each fast path is given random
+/// settings and evaluated at `m_nPoints` random points (or on a pyramid of
+/// `m_nPyramidLevels` levels, or on `m_nPatches` patches) and compared with
+/// the reference. The first failure on each path is minimized if it fails
+/// on its own, that is, not just as part of a batch.
+/// \param nCases Number of test cases for each path.
+/// \return Wide string report, with a summary followed by one line per
+/// path giving a reproducer if it failed.
+
+const std::wstring CFuzzer::Run(size_t nCases){
+  struct Path{ //an evaluation path to test
+    eFuzzPath ePath; ///< Evaluation path.
+    eISA eISAType; ///< Instruction set.
+    std::wstring wstrName; ///< Name.
+    std::wstring wstrResult; ///< Result.
+  }; //Path
+
+  std::vector<Path> path; //evaluation paths
+
+  const eISA isa[] = {eISA::SSE2, eISA::AVX2, eISA::AVX512}; //SIMD kernels
+  const std::wstring isaname[] = {L"SSE2", L"AVX2", L"AVX-512"}; //names
+
+  for(size_t i=0; i<3; i++)
+    if(ISASupported(isa[i])){
+      path.push_back({eFuzzPath::Batch, isa[i], L"Batch " + isaname[i], L""});
+      path.push_back({eFuzzPath::Warp, isa[i], L"Warp " + isaname[i], L""});
+      path.push_back({eFuzzPath::Fused, isa[i], L"Fused " + isaname[i], L""});
+    } //if
+
+  path.push_back({eFuzzPath::Pyramid, eISA::Scalar, L"Pyramid", L""});
+  path.push_back({eFuzzPath::Fixed, eISA::Scalar, L"Fixed point", L""});
+  path.push_back({eFuzzPath::Patches, BestISA(), L"Patches", L""});
+
+  for(size_t k=0; k<nCases; k++) //for each test case
+    for(Path& p: path){ //for each path
+      if(!p.wstrResult.empty())continue; //already failed
+
+      FuzzCase c = RandomCase(p.ePath, p.eISAType); //test case
+      std::vector<FuzzCase> point; //test case for each point
+      std::vector<float> ref, fast; //noise values
+
+      if(p.ePath == eFuzzPath::Pyramid){
+        c.dX = RandomCoordinate(c.nTableSize);
+        c.dY = RandomCoordinate(c.nTableSize);
+        EvaluatePyramid(c, point, ref, fast);
+      } //if
+
+      else if(p.ePath == eFuzzPath::Patches){
+        c.dX = RandomCoordinate(c.nTableSize);
+        c.dY = RandomCoordinate(c.nTableSize);
+        EvaluatePatches(c, point, ref, fast);
+      } //else if
+
+      else{
+        point.assign(m_nPoints, c);
+
+        for(FuzzCase& d: point){
+          d.dX = RandomCoordinate(c.nTableSize);
+          d.dY = RandomCoordinate(c.nTableSize);
+
+          if(p.ePath == eFuzzPath::Fixed){ //Q16, small enough for 8 octaves
+            d.dX = ldexp(round(ldexp(fmod(d.dX, ldexp(1.0, 30)), 16)), -16);
+            d.dY = ldexp(round(ldexp(fmod(d.dY, ldexp(1.0, 30)), 16)), -16);
+          } //if
+        } //for
+
+        Evaluate(point, ref, fast);
+      } //else
+
+      for(size_t i=0; i<point.size(); i++)
+        if(Mismatch(point[i], ref[i], fast[i])){
+          FuzzCase d = point[i]; //failing case
+
+          if(Fails(d)){
+            Minimize(d);
+            p.wstrResult = L"FAILED\n" + Describe(d);
+          } //if
+
+          else p.wstrResult = L"FAILED in a batch only\n" + Describe(d);
+
+          break;
+        } //if
+    } //for
+
+  size_t nFailed = 0; //number of paths that failed
+  std::wstring wstrDetail; //one line per path
+
+  for(Path& p: path){
+    if(p.wstrResult.empty())p.wstrResult = L"passed";
+    else nFailed++;
+    wstrDetail += p.wstrName + L": " + p.wstrResult + L"\n";
+  } //for
+
+  std::wstring wstr = nFailed? L"FAIL: ": L"PASS: ";
+  wstr += std::to_wstring(path.size() - nFailed) + L" of ";
+  wstr += std::to_wstring(path.size()) + L" paths passed ";
+  wstr += std::to_wstring(nCases) + L" test cases with seed ";
+  wstr += std::to_wstring(m_nSeed) + L".\n";
+
+  return wstr + wstrDetail;
+} //Run
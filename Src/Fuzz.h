@@ -0,0 +1,124 @@
+/// \file Fuzz.h
+///
+/// \brief Interface for the differential fuzzer.
+
+// MIT License
+//
+// Copyright (c) 2022 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#ifndef __FUZZ_H__
+#define __FUZZ_H__
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "perlin.h"
+
+/// \brief Fast evaluation path.
+///
+/// Enumerated type for the evaluation paths that the differential fuzzer
+/// checks against `CPerlinNoise2D::generate()`. `Batch` is
+/// `generatebatch()`, `Warp` is `generatewarp()`, and `Fused` is
+/// `generatefused()` using a SIMD batch kernel, `Pyramid` is the mip chain
+/// from `generatepyramid()`, `Fixed` is fixed-point noise from
+/// `generatefixed()`, and `Patches` is `generatepatches()`.
+
+enum class eFuzzPath{
+  Batch, Warp, Pyramid, Fixed, Fused, Patches
+}; //eFuzzPath
+
+/// \brief Differential fuzzer test case.
+///
+/// Everything needed to reproduce one evaluation of noise at a point by one
+/// of the fast paths. The generator is seeded with `nSeed` using
+/// `CPerlinNoise2D::Reseed()` after the other settings are made.
+
+struct FuzzCase{
+  eFuzzPath ePath = eFuzzPath::Batch; ///< Evaluation path.
+  eISA eISAType = eISA::Scalar; ///< Instruction set for the batch kernels.
+  eNoise eNoiseType = eNoise::Perlin; ///< Noise type.
+  eHash eHashType = eHash::Permutation; ///< Hash function.
+  eSpline eSplineType = eSpline::Cubic; ///< Spline function.
+  eDistribution eDistType = eDistribution::Uniform; ///< Distribution.
+  eFractal eFractalType = eFractal::Sum; ///< Octave combination.
+  eWorley eWorleyType = eWorley::F1; ///< Worley noise distance.
+  size_t nTableSize = 256; ///< Table size.
+  size_t nOctaves = 1; ///< Number of octaves.
+  float fAlpha = 0.5f; ///< Lacunarity.
+  float fBeta = 2.0f; ///< Persistence.
+  float fFootprint = 1.0f/16.0f; ///< Sample spacing for `Pyramid`.
+  size_t nWarpOctaves[2] = {2, 4}; ///< Warp field octaves for `Warp`.
+  float fWarpStrength = 2.0f; ///< Warp strength for `Warp`.
+  UINT nSeed = 0; ///< PRNG seed.
+  double dX = 0.0; ///< X-coordinate.
+  double dY = 0.0; ///< Y-coordinate.
+}; //FuzzCase
+
+/// \brief Differential fuzzer.
+///
+/// Checks every fast evaluation path against the reference
+/// `CPerlinNoise2D::generate()` at random points with random settings. The
+/// points include ordinary ones, huge ones, ones on or next to cell
+/// boundaries and table size multiples, and ones next to zero and the
+/// denormals. The batch, warp, fused, pyramid, and patch paths must match
+/// the reference exactly (the reference for the warp path is its own scalar
+/// code) and fixed-point noise must match it within a tolerance. The first
+/// failure on each path is minimized, that is, its settings and coordinates
+/// are made as simple as possible while it still fails, and reported as a
+/// reproducer.
+
+class CFuzzer{
+  private:
+    CPerlinNoise2D m_cPerlin; ///< Noise generator.
+    std::mt19937_64 m_cRandom; ///< PRNG for test cases.
+    uint64_t m_nSeed = 0; ///< Seed for `m_cRandom`.
+
+    const size_t m_nPoints = 64; ///< Points per test case.
+    const size_t m_nPyramidSize = 16; ///< Width of level 0 of pyramids.
+    const size_t m_nPyramidLevels = 3; ///< Number of levels of pyramids.
+    const size_t m_nFused = 3; ///< Generators per fused test case.
+    const size_t m_nPatches = 3; ///< Seeds per patch test case.
+    const size_t m_nPatchSize = 8; ///< Width and height of patches.
+    const float m_fFixedTolerance = 0.002f; ///< Fixed-point error tolerance.
+
+    const double RandomCoordinate(size_t); ///< Random coordinate.
+    const FuzzCase RandomCase(eFuzzPath, eISA); ///< Random test case.
+
+    void Configure(CPerlinNoise2D&, const FuzzCase&); ///< Set up generator.
+    void Evaluate(const std::vector<FuzzCase>&, std::vector<float>&,
+      std::vector<float>&); ///< Evaluate points by reference and fast path.
+    void EvaluatePyramid(const FuzzCase&, std::vector<FuzzCase>&,
+      std::vector<float>&, std::vector<float>&); ///< Evaluate a pyramid.
+    void EvaluatePatches(const FuzzCase&, std::vector<FuzzCase>&,
+      std::vector<float>&, std::vector<float>&); ///< Evaluate patches.
+    const bool Mismatch(const FuzzCase&, float, float) const; ///< Compare.
+    const bool Fails(const FuzzCase&); ///< Test a single point.
+    const bool Try(FuzzCase&, const FuzzCase&); ///< Try a simpler case.
+    void Minimize(FuzzCase&); ///< Minimize a failing case.
+    const std::wstring Describe(const FuzzCase&); ///< Describe a case.
+
+  public:
+    CFuzzer(uint64_t); ///< Constructor.
+    const std::wstring Run(size_t); ///< Run the fuzzer.
+}; //CFuzzer
+
+#endif //__FUZZ_H__
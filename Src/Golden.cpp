@@ -0,0 +1,265 @@
+/// \file Golden.cpp
+///
+/// \brief Code for the golden image regression harness.
+
+// MIT License
+//
+// Copyright (c) 2022 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+#include "Golden.h"
+#include "Helpers.h"
+
+/// Get the number of configurations in the regression matrix, which is the
+/// number of combinations of noise type, hash function, spline function,
+/// and distribution.
+/// \return Number of configurations.
+
+const size_t CGolden::GetNumConfigs() const{
+  return 4*5*3*6;
+} //GetNumConfigs
+
+/// Set up a noise generator for a configuration of the regression matrix.
+/// The settings that are not part of the matrix proper are cycled through
+/// at rates that are not multiples of each other.
+/// \param perlin [IN, OUT] Noise generator.
+/// \param c Configuration number, less than `GetNumConfigs()`.
+/// \param t [OUT] Noise type.
+/// \param n [OUT] Number of octaves.
+/// \param x [OUT] X-coordinate of origin.
+/// \param y [OUT] Y-coordinate of origin.
+
+void CGolden::Configure(CPerlinNoise2D& perlin, size_t c, eNoise& t,
+  size_t& n, double& x, double& y) const
+{
+  const eNoise noise[] = {eNoise::Perlin, eNoise::Value, eNoise::Simplex,
+    eNoise::Worley}; //noise types
+  const eHash hash[] = {eHash::Permutation, eHash::LinearCongruential,
+    eHash::Std, eHash::Stateless, eHash::Coprime}; //hash functions
+  const eSpline spline[] = {eSpline::None, eSpline::Cubic,
+    eSpline::Quintic}; //spline functions
+  const eDistribution dist[] = {eDistribution::Uniform, eDistribution::Cosine,
+    eDistribution::Normal, eDistribution::Exponential,
+    eDistribution::Midpoint, eDistribution::Maximal}; //distributions
+  const eFractal fractal[] = {eFractal::Sum, eFractal::Turbulence,
+    eFractal::Billow, eFractal::Ridged}; //octave combinations
+  const eWorley worley[] = {eWorley::F1, eWorley::F2,
+    eWorley::F2MinusF1}; //Worley distances
+
+  const size_t size[] = {16, 256, 4096, 65536}; //table sizes
+  const size_t octaves[] = {1, 4, 8}; //numbers of octaves
+  const double origin[][2] = {{0.0, 0.0}, {-100.3, 37.1},
+    {123456789.5, -987654.25}}; //origins
+
+  t = noise[c/90];
+  n = octaves[(c/3)%3];
+  x = origin[(c/5)%3][0];
+  y = origin[(c/5)%3][1];
+
+  while(perlin.HalveTableSize()); //start at the minimum table size
+  while(perlin.GetTableSize() < size[(c/2)%4] && perlin.DoubleTableSize());
+
+  perlin.SetHash(hash[(c/18)%5]);
+  perlin.SetSpline(spline[(c/6)%3]);
+  perlin.SetFractal(fractal[(c/7)%4]);
+  perlin.SetWorley(worley[(c/11)%3]);
+  perlin.SetTime(0.0);
+  perlin.RandomizeTable(dist[c%6]);
+  perlin.Reseed(m_nSeed);
+} //Configure
+
+/// Describe a configuration of the regression matrix.
+/// \param c Configuration number, less than `GetNumConfigs()`.
+/// \return Wide string description.
+
+const std::wstring CGolden::Describe(size_t c) const{
+  const std::wstring noise[] = {L"Perlin", L"Value", L"Simplex", L"Worley"};
+  const std::wstring hash[] = {L"permutation", L"linear congruential",
+    L"std::hash", L"table-free", L"coprime"};
+  const std::wstring spline[] = {L"no spline", L"cubic", L"quintic"};
+  const std::wstring dist[] = {L"uniform", L"cosine", L"normal",
+    L"exponential", L"midpoint", L"maximal"};
+  const std::wstring fractal[] = {L"sum", L"turbulence", L"billow",
+    L"ridged"};
+  const std::wstring size[] = {L"16", L"256", L"4096", L"65536"};
+  const std::wstring octaves[] = {L"1", L"4", L"8"};
+
+  std::wstring wstr = std::to_wstring(c) + L" " + noise[c/90] + L", ";
+  wstr += hash[(c/18)%5] + L", " + spline[(c/6)%3] + L", " + dist[c%6];
+  wstr += L", " + fractal[(c/7)%4] + L", table " + size[(c/2)%4];
+  wstr += L", octaves " + octaves[(c/3)%3];
+  wstr += L", origin " + std::to_wstring((c/5)%3);
+
+  if(c/90 == 3) //Worley
+    wstr += L", F" + std::wstring((c/11)%3 == 0? L"1": (c/11)%3 == 1? L"2":
+      L"2-F1");
+
+  return wstr;
+} //Describe
+
+/// Render every configuration of the regression matrix using a separate
+/// noise generator and make its golden record. The checksum is 64-bit
+/// FNV-1a of the bits of the noise values, so it changes if any value
+/// changes at all.
+/// \param isa Instruction set for the batch kernels.
+
+void CGolden::Generate(eISA isa){
+  const size_t n = m_nImageSize*m_nImageSize; //number of pixels
+  assert(n*sizeof(float) == sizeof(GoldenRecord::fImage)); //image fits
+
+  double* pX = new double[n]; //X-coordinates
+  double* pY = new double[n]; //Y-coordinates
+  float* pResult = new float[n]; //noise values
+
+  CPerlinNoise2D perlin; //noise generator
+  perlin.SetISA(isa);
+
+  m_vRecord.resize(GetNumConfigs());
+
+  for(size_t c=0; c<GetNumConfigs(); c++){ //for each configuration
+    eNoise t = eNoise::Perlin; //noise type
+    size_t nOctaves = 1; //number of octaves
+    double x = 0.0, y = 0.0; //origin
+
+    Configure(perlin, c, t, nOctaves, x, y);
+
+    for(size_t j=0; j<m_nImageSize; j++)
+      for(size_t i=0; i<m_nImageSize; i++){
+        pX[j*m_nImageSize + i] = x + i*m_fSpacing;
+        pY[j*m_nImageSize + i] = y + j*m_fSpacing;
+      } //for
+
+    perlin.generatebatch(pX, pY, n, pResult, t, nOctaves);
+
+    GoldenRecord& r = m_vRecord[c]; //record for this configuration
+    r.nConfig = (uint32_t)c;
+    r.nChecksum = 0xCBF29CE484222325ULL; //FNV-1a offset basis
+
+    const uint8_t* p = (const uint8_t*)pResult; //bytes of noise values
+
+    for(size_t i=0; i<n*sizeof(float); i++)
+      r.nChecksum = (r.nChecksum ^ p[i])*0x100000001B3ULL; //FNV-1a prime
+
+    std::copy(pResult, pResult + n, r.fImage);
+  } //for
+
+  delete [] pX;
+  delete [] pY;
+  delete [] pResult;
+} //Generate
+
+/// Save the golden records to a binary stream, preceded by a header with a
+/// tag, the number of records, the image size, and the record size.
+/// \param s Output stream, which should be opened in binary mode.
+
+void CGolden::Save(std::ostream& s) const{
+  const uint32_t header[4] = {0x444C4F47, (uint32_t)m_vRecord.size(),
+    (uint32_t)m_nImageSize, (uint32_t)sizeof(GoldenRecord)}; //"GOLD", sizes
+
+  s.write((const char*)header, sizeof(header));
+  s.write((const char*)m_vRecord.data(),
+    m_vRecord.size()*sizeof(GoldenRecord));
+} //Save
+
+/// Load golden records from a binary stream saved by `Save()`.
+/// \param s Input stream, which should be opened in binary mode.
+/// \return true if the records were loaded.
+
+const bool CGolden::Load(std::istream& s){
+  uint32_t header[4] = {0}; //tag and sizes
+  s.read((char*)header, sizeof(header));
+
+  if(!s || header[0] != 0x444C4F47 || header[2] != m_nImageSize ||
+    header[3] != sizeof(GoldenRecord) || header[1] > GetNumConfigs())
+      return false;
+
+  m_vRecord.resize(header[1]);
+  s.read((char*)m_vRecord.data(), m_vRecord.size()*sizeof(GoldenRecord));
+
+  if(!s){
+    m_vRecord.clear();
+    return false;
+  } //if
+
+  return true;
+} //Load
+
+/// Compare with golden records that are known to be good. Each configuration
+/// is exact if its checksum and every pixel match, passes if its largest
+/// difference from the reference image over every pixel is within a
+/// tolerance, and fails otherwise.
+/// \param ref Reference records.
+/// \param fTolerance Largest difference allowed.
+/// \return Wide string report, with a summary followed by one line per
+/// configuration giving its maximum error.
+
+const std::wstring CGolden::Compare(const CGolden& ref, float fTolerance)
+  const
+{
+  size_t nExact = 0, nPass = 0, nFail = 0, nMissing = 0; //counts
+  float fMaxError = 0.0f; //largest error over all configurations
+  std::wstring wstrDetail; //one line per configuration
+
+  for(const GoldenRecord& r: m_vRecord){
+    wstrDetail += Describe(r.nConfig) + L": ";
+
+    const auto p = std::find_if(ref.m_vRecord.begin(), ref.m_vRecord.end(),
+      [&](const GoldenRecord& g){return g.nConfig == r.nConfig;});
+
+    if(p == ref.m_vRecord.end()){ //not in reference
+      wstrDetail += L"missing\n";
+      nMissing++;
+      continue;
+    } //if
+
+    float fError = 0.0f; //largest error in this configuration
+
+    for(size_t i=0; i<m_nImageSize*m_nImageSize; i++)
+      fError = std::max<float>(fError, fabsf(r.fImage[i] - p->fImage[i]));
+
+    fMaxError = std::max<float>(fMaxError, fError);
+
+    if(r.nChecksum == p->nChecksum && fError == 0.0f){
+      wstrDetail += L"exact\n";
+      nExact++;
+    } //if
+
+    else{
+      const bool bPass = fError <= fTolerance; //within tolerance
+      wstrDetail += L"max error " + to_wstring_f(fError, 7) +
+        (bPass? L"\n": L" FAILED\n");
+      (bPass? nPass: nFail)++;
+    } //else
+  } //for
+
+  std::wstring wstr = (nFail + nMissing == 0)? L"PASS: ": L"FAIL: ";
+  wstr += std::to_wstring(nExact) + L" exact, ";
+  wstr += std::to_wstring(nPass) + L" within " + to_wstring_f(fTolerance, 7);
+  wstr += L", " + std::to_wstring(nFail) + L" failed, ";
+  wstr += std::to_wstring(nMissing) + L" missing. Max error ";
+  wstr += to_wstring_f(fMaxError, 7) + L".\n";
+
+  return wstr + wstrDetail;
+} //Compare
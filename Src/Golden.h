@@ -0,0 +1,85 @@
+/// \file Golden.h
+///
+/// \brief Interface for the golden image regression harness.
+
+// MIT License
+//
+// Copyright (c) 2022 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#ifndef __GOLDEN_H__
+#define __GOLDEN_H__
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "perlin.h"
+
+/// \brief Golden record.
+///
+/// The result of rendering one configuration of the regression matrix: a
+/// checksum of the bits of the image, for exact comparison, and the image
+/// itself, for comparison within a tolerance at every pixel.
+
+struct GoldenRecord{
+  uint32_t nConfig = 0; ///< Configuration number.
+  uint64_t nChecksum = 0; ///< FNV-1a checksum of the image.
+  float fImage[64*64] = {0}; ///< Image, row-major.
+}; //GoldenRecord
+
+/// \brief Golden image regression harness.
+///
+/// Renders a fixed matrix of configurations with a fixed seed so that a
+/// change to the noise generator or its batch kernels can be checked
+/// against the output of a version that is known to be good. The matrix is
+/// every combination of noise type, hash function, spline function, and
+/// distribution. The table size, number of octaves, origin, octave
+/// combination, and Worley distance are cycled through at different rates
+/// so that every one of their values is used with every noise type. The
+/// records can be saved to and loaded from a stream, and two sets of
+/// records can be compared configuration by configuration. Nothing here
+/// depends on Windows, so the harness can also be built with the portable
+/// part of the noise generator and run from the command line by the program
+/// in `GoldenMain.cpp`.
+
+class CGolden{
+  private:
+    std::vector<GoldenRecord> m_vRecord; ///< One record per configuration.
+
+    const size_t m_nImageSize = 64; ///< Width and height of rendered images.
+    const float m_fSpacing = 1.0f/16.0f; ///< Distance between pixels.
+    const UINT m_nSeed = 0x5EED; ///< PRNG seed.
+
+    void Configure(CPerlinNoise2D&, size_t, eNoise&, size_t&, double&,
+      double&) const; ///< Set up a configuration.
+
+  public:
+    const size_t GetNumConfigs() const; ///< Get number of configurations.
+    const std::wstring Describe(size_t) const; ///< Describe a configuration.
+
+    void Generate(eISA); ///< Render every configuration.
+    void Save(std::ostream&) const; ///< Save records to a stream.
+    const bool Load(std::istream&); ///< Load records from a stream.
+    const std::wstring Compare(const CGolden&, float) const; ///< Compare with reference.
+}; //CGolden
+
+#endif //__GOLDEN_H__
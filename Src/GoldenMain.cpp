@@ -0,0 +1,231 @@
+/// \file GoldenMain.cpp
+///
+/// \brief Command-line runner for the golden image regression harness and
+/// the statistics reproducibility check.
+///
+/// This is not part of the Windows project. It depends only on the portable
+/// part of the noise generator, so it can be built on any platform with a
+/// C++17 compiler, for example with g++ as follows. The kernels must not
+/// contract multiplies and adds, since MSVC does not.
+///
+/// \code
+/// g++ -std=c++17 -O2 -ffp-contract=off -c Kernels.cpp KernelsSSE2.cpp
+/// g++ -std=c++17 -O2 -ffp-contract=off -mavx2 -c KernelsAVX2.cpp
+/// g++ -std=c++17 -O2 -ffp-contract=off -mavx512f -c KernelsAVX512.cpp
+/// g++ -std=c++17 -O2 -ffp-contract=off -o golden GoldenMain.cpp Golden.cpp
+///   Stats.cpp perlin.cpp Helpers.cpp Kernels*.o -pthread
+/// \endcode
+///
+/// Run `golden save file.golden` with a version of the noise generator that
+/// is known to be good, then `golden check file.golden` after a change. Run
+/// `golden stats` to check that noise statistics gathered per tile on any
+/// number of threads reduce to the same bits as on one thread. An
+/// instruction set `scalar`, `sse2`, `avx2`, or `avx512` can be given after
+/// the file name, or after `stats`. The default is the best one that the
+/// processor supports. The exit code is 0 if and only if the command
+/// succeeded and every check passed.
+
+// MIT License
+//
+// Copyright (c) 2022 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "Golden.h"
+#include "Stats.h"
+
+const float GOLDEN_TOLERANCE = 1.0e-5f; ///< Golden image error tolerance.
+const size_t STATS_SIZE = 512; ///< Width and height of the statistics image.
+const size_t STATS_TILE_ROWS = 16; ///< Rows of pixels per statistics tile.
+
+/// Parse an instruction set name.
+/// \param s Instruction set name, or `nullptr` for the best supported one.
+/// \param isa [OUT] Instruction set.
+/// \return true if the name was recognized and the processor supports it.
+
+static const bool ParseISA(const char* s, eISA& isa){
+  isa = BestISA();
+
+  if(s == nullptr)return true;
+  else if(strcmp(s, "scalar") == 0)isa = eISA::Scalar;
+  else if(strcmp(s, "sse2")   == 0)isa = eISA::SSE2;
+  else if(strcmp(s, "avx2")   == 0)isa = eISA::AVX2;
+  else if(strcmp(s, "avx512") == 0)isa = eISA::AVX512;
+  else return false;
+
+  return ISASupported(isa);
+} //ParseISA
+
+/// Render the golden images and save them to a file.
+/// \param file File name.
+/// \param isa Instruction set for the batch kernels.
+/// \return Exit code, 0 for success.
+
+static int Save(const char* file, eISA isa){
+  CGolden golden; //golden images
+  golden.Generate(isa);
+
+  std::ofstream s(file, std::ios::binary); //output file
+  golden.Save(s);
+
+  if(!s){
+    std::cerr << "Could not save golden images to " << file << ".\n";
+    return 1;
+  } //if
+
+  std::cout << golden.GetNumConfigs() << " golden images saved to " << file
+    << ".\n";
+  return 0;
+} //Save
+
+/// Render the golden images and compare them with the ones in a file,
+/// writing the full report to the standard output.
+/// \param file File name.
+/// \param isa Instruction set for the batch kernels.
+/// \return Exit code, 0 if every configuration passed.
+
+static int Check(const char* file, eISA isa){
+  CGolden ref; //golden images known to be good
+  std::ifstream s(file, std::ios::binary); //input file
+
+  if(!ref.Load(s)){
+    std::cerr << "Could not load golden images from " << file << ".\n";
+    return 1;
+  } //if
+
+  CGolden golden; //golden images from the current code
+  golden.Generate(isa);
+
+  const std::wstring wstr = golden.Compare(ref, GOLDEN_TOLERANCE); //report
+  std::wcout << wstr;
+
+  return wstr.compare(0, 5, L"PASS:") == 0? 0: 1;
+} //Check
+
+/// Generate noise for every \f$n\f$-th tile of `STATS_TILE_ROWS` rows of
+/// pixels starting at a given tile and gather the statistics of each tile,
+/// in the same way that `CMain::GetNoiseTiles()` does for the bitmap.
+/// \param perlin Noise generator.
+/// \param pNoise [OUT] Array of noise values, one per pixel, row-major.
+/// \param first First tile.
+/// \param n Distance between tiles.
+/// \param pStats [OUT] Array of statistics, one per tile.
+
+static void GetStatsTiles(const CPerlinNoise2D* perlin, float* pNoise,
+  size_t first, size_t n, CNoiseStats* pStats)
+{
+  const size_t w = STATS_SIZE; //image width
+  double pX[STATS_SIZE], pY[STATS_SIZE]; //coordinates of a row
+
+  for(size_t k=first; k*STATS_TILE_ROWS<STATS_SIZE; k+=n) //for each tile
+    for(size_t j=k*STATS_TILE_ROWS; j<(k + 1)*STATS_TILE_ROWS; j++){
+      for(size_t i=0; i<w; i++){
+        pX[i] = -3.7 + i/64.0;
+        pY[i] = 11.2 + j/64.0;
+      } //for
+
+      perlin->generatebatch(pX, pY, w, &pNoise[j*w], eNoise::Perlin, 8);
+      pStats[k].Add(&pNoise[j*w], w);
+    } //for
+} //GetStatsTiles
+
+/// Generate noise with its statistics on one thread, then on every number of
+/// threads up to the hardware concurrency (but at least four) and on more
+/// threads than there are tiles, and check that every reduction with
+/// `CNoiseStats::Reduce()` is bit-for-bit the same as the one from a single
+/// thread.
+/// \param isa Instruction set for the batch kernels.
+/// \return Exit code, 0 if every reduction was the same.
+
+static int CheckStats(eISA isa){
+  const size_t nTiles = STATS_SIZE/STATS_TILE_ROWS; //number of tiles
+  const size_t nMax = std::max<size_t>(4, std::thread::hardware_concurrency());
+
+  CPerlinNoise2D perlin; //noise generator
+  perlin.SetISA(isa);
+  perlin.Reseed(0x5EED);
+
+  float* pNoise = new float[STATS_SIZE*STATS_SIZE]; //noise values
+  CNoiseStats stats1; //statistics for one thread
+  size_t nFail = 0; //number of thread counts that differ
+
+  for(size_t n=1; n<=nMax + 1; n++){ //number of threads
+    const size_t nThreads = (n <= nMax)? n: nTiles + 1; //last has idle threads
+    std::vector<CNoiseStats> tile(nTiles); //statistics per tile
+    std::vector<std::thread> thread; //worker threads
+
+    for(size_t i=0; i<nThreads; i++)
+      thread.push_back(std::thread(GetStatsTiles, &perlin, pNoise, i,
+        nThreads, tile.data()));
+
+    for(std::thread& th: thread)
+      th.join();
+
+    CNoiseStats stats; //statistics for this many threads
+    stats.Reduce(tile);
+
+    if(n == 1)stats1 = stats;
+    const bool bSame = stats == stats1; //same as for one thread
+    if(!bSame)nFail++;
+
+    std::cout << nThreads << " threads: mean " << stats.GetMean() <<
+      ", variance " << stats.GetVariance() << (bSame? "\n": " DIFFERENT\n");
+  } //for
+
+  delete [] pNoise;
+
+  std::cout << (nFail == 0? "PASS": "FAIL") << ": statistics of " <<
+    STATS_SIZE << "x" << STATS_SIZE << " pixels in " << nTiles <<
+    " tiles are " << (nFail == 0? "identical": "NOT identical") <<
+    " for 1 to " << nMax << " and " << nTiles + 1 << " threads.\n";
+
+  return nFail == 0? 0: 1;
+} //CheckStats
+
+/// Run a command given on the command line.
+/// \param argc Number of command-line arguments.
+/// \param argv Command-line arguments.
+/// \return Exit code, 0 for success.
+
+int main(int argc, char* argv[]){
+  eISA isa = eISA::Scalar; //instruction set
+
+  if(argc >= 2 && strcmp(argv[1], "stats") == 0 && argc <= 3 &&
+    ParseISA(argc == 3? argv[2]: nullptr, isa))
+      return CheckStats(isa);
+
+  if(argc < 3 || argc > 4 || !ParseISA(argc == 4? argv[3]: nullptr, isa)){
+    std::cerr << "Usage: " << argv[0] <<
+      " save|check file [scalar|sse2|avx2|avx512]\n" <<
+      "       " << argv[0] << " stats [scalar|sse2|avx2|avx512]\n";
+    return 2;
+  } //if
+
+  if(strcmp(argv[1], "save") == 0)return Save(argv[2], isa);
+  if(strcmp(argv[1], "check") == 0)return Check(argv[2], isa);
+
+  std::cerr << "Unknown command " << argv[1] << ".\n";
+  return 2;
+} //main
@@ -73,7 +73,7 @@ const float clamp(float a, float x, float b){
 /// \param n Number of digits after the decimal point.
 /// \return Fixed precision string.
 
-std::wstring to_wstring_f(float x, size_t n){
+std::wstring to_wstring_f(double x, size_t n){
   std::wstringstream s; //convertor
   s.precision(n); //set precision
   s << std::fixed << x; //convert x
@@ -35,7 +35,7 @@ const float spline5(float); ///< Quintic spline.
 const float lerp(float, float, float); ///< Linear interpolation.
 const float clamp(float, float, float); ///< Clamp between two values.
 
-std::wstring to_wstring_f(float x, size_t n); ///< Float to fixed precision wstring.
+std::wstring to_wstring_f(double x, size_t n); ///< Float to fixed precision wstring.
 const bool isPowerOf2(size_t n); ///< Power of 2 test. 
 
 #endif //__HELPERS_H__
\ No newline at end of file
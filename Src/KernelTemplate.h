@@ -0,0 +1,571 @@
+/// \file KernelTemplate.h
+///
+/// \brief The batch noise kernel algorithm, independent of instruction set.
+///
+/// This header is included by the instruction set specific source files only.
+/// Each of them defines a class of static inline wrappers for its intrinsics
+/// and instantiates the template with it. The operations are performed in
+/// exactly the same order as in the scalar code in `perlin.cpp`, so
+/// each kernel gets the same results as `CPerlinNoise2D::generate()`.
+
+// MIT License
+//
+// Copyright (c) 2022 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#ifndef __KERNELTEMPLATE_H__
+#define __KERNELTEMPLATE_H__
+
+#include "Kernels.h"
+
+/// Compute a spline function on a vector of floats. This is the vector
+/// equivalent of `CPerlinNoise2D::spline()`, and is clamped in the same way.
+/// \tparam V Instruction set wrapper class.
+/// \param x A vector of floats in the range \f$[0, 1]\f$.
+/// \param s Spline function type.
+/// \return The spline of each entry of \f$\mathsf{x}\f$.
+
+template<class V> 
+inline typename V::F KernelSpline(typename V::F x, eSpline s){
+  typename V::F r = x; //result
+
+  switch(s){
+    case eSpline::Cubic: //t*t*(3 - 2*t)
+      r = V::mul(V::mul(x, x),
+        V::sub(V::set1(3.0f), V::mul(V::set1(2.0f), x)));
+    break;
+
+    case eSpline::Quintic: //t*t*t*(10 + 3*t*(2*t - 5))
+      r = V::mul(V::mul(V::mul(x, x), x),
+        V::add(V::set1(10.0f), V::mul(V::mul(V::set1(3.0f), x),
+          V::sub(V::mul(V::set1(2.0f), x), V::set1(5.0f)))));
+    break;
+
+    default: break;
+  } //switch
+
+  return V::max(V::set1(-1.0f), V::min(r, V::set1(1.0f))); //clamp
+} //KernelSpline
+
+/// Apply the permutation to a vector of integers. This is the vector
+/// equivalent of `CPerlinNoise2D::hash()`.
+/// \tparam V Instruction set wrapper class.
+/// \param a Kernel arguments.
+/// \param x Vector of integers less than the permutation size.
+/// \return Vector of permuted integers.
+
+template<class V> 
+inline typename V::I KernelHash(const KernelArgs& a, typename V::I x){
+  if(a.nHiMask == 0) //one-level permutation
+    return V::gather(a.pPerm, x);
+
+  const typename V::I hi = V::srli(x, a.nBlockBits); //high bits
+  const typename V::I lo = V::gather(a.pPermLo, V::xori(
+    V::andi(x, V::set1i((1 << a.nBlockBits) - 1)),
+    V::gather(a.pKeyHi, hi))); //new low bits
+
+  return V::addi(V::slli(V::gather(a.pPermHi,
+    V::xori(hi, V::gather(a.pKeyLo, lo))), a.nBlockBits), lo);
+} //KernelHash
+
+/// Get the Z-values at a vector of hashed lattice points. This is the vector
+/// equivalent of `CPerlinNoise2D::z()`.
+/// \tparam V Instruction set wrapper class.
+/// \param a Kernel arguments.
+/// \param h Vector of hash values for gradient table indices.
+/// \param x Vector of X-coordinates relative to the lattice points.
+/// \param y Vector of Y-coordinates relative to the lattice points.
+/// \return Vector of Z-values.
+
+template<class V> 
+inline typename V::F KernelZ(const KernelArgs& a, typename V::I h,
+  typename V::F x, typename V::F y)
+{
+  const typename V::I tmask = V::set1i(a.nTableMask); //table size mask
+
+  if(a.eNoiseType == eNoise::Value)
+    return V::gather(a.pTable, V::andi(h, tmask));
+
+  const typename V::I g = V::andi(KernelHash<V>(a, h), tmask); //index of Y gradient
+  return V::add(V::mul(x, V::gather(a.pTable, V::andi(h, tmask))),
+    V::mul(y, V::gather(a.pTable, g)));
+} //KernelZ
+
+/// Linear interpolation on vectors, \f$a + t(b - a)\f$.
+/// \tparam V Instruction set wrapper class.
+/// \param t Vector of interpolation fractions.
+/// \param a Vector of lower values.
+/// \param b Vector of upper values.
+/// \return Vector of interpolated values.
+
+template<class V> 
+inline typename V::F KernelLerp(typename V::F t, typename V::F a,
+  typename V::F b)
+{
+  return V::add(a, V::mul(t, V::sub(b, a)));
+} //KernelLerp
+
+/// Hash the four corners of the lattice cells containing a vector of points.
+/// This is the vector equivalent of `CPerlinNoise2D::HashCorners()`.
+/// \tparam V Instruction set wrapper class.
+/// \param a Kernel arguments.
+/// \param cx Vector of masked lattice cell X-coordinates.
+/// \param cy Vector of masked lattice cell Y-coordinates.
+/// \param c [OUT] Array of four vectors of corner hash values in row-major
+/// order.
+
+template<class V> 
+inline void KernelCorners(const KernelArgs& a, typename V::I cx,
+  typename V::I cy, typename V::I c[4])
+{
+  typedef typename V::I I; //vector of 32-bit integers
+
+  const I mask = V::set1i(a.nMask); //table size mask
+  const I one = V::set1i(1); //integer one
+
+  //c[k] = perm[(perm[x] + y) & mask]
+
+  const I px0 = KernelHash<V>(a, cx); 
+  const I px1 = KernelHash<V>(a, V::andi(V::addi(cx, one), mask)); 
+  const I cy1 = V::addi(cy, one);
+
+  c[0] = KernelHash<V>(a, V::andi(V::addi(px0, cy), mask));
+  c[1] = KernelHash<V>(a, V::andi(V::addi(px1, cy), mask));
+  c[2] = KernelHash<V>(a, V::andi(V::addi(px0, cy1), mask));
+  c[3] = KernelHash<V>(a, V::andi(V::addi(px1, cy1), mask));
+} //KernelCorners
+
+/// Interpolate the Z-values at the four hashed corners of the lattice cells
+/// containing a vector of points, along the X-axis then the Y-axis.
+/// \tparam V Instruction set wrapper class.
+/// \param a Kernel arguments.
+/// \param c Array of four vectors of corner hash values in row-major order.
+/// \param sx Vector of smoothed fractional parts of X-coordinates.
+/// \param sy Vector of smoothed fractional parts of Y-coordinates.
+/// \param fx Vector of fractional parts of X-coordinates.
+/// \param fy Vector of fractional parts of Y-coordinates.
+/// \return Vector of noise values.
+
+template<class V> 
+inline typename V::F KernelBilerp(const KernelArgs& a, const typename V::I c[4],
+  typename V::F sx, typename V::F sy, typename V::F fx, typename V::F fy)
+{
+  typedef typename V::F F; //vector of floats
+
+  const F fone = V::set1(1.0f); //float one
+  const F fx1 = V::sub(fx, fone);
+  const F fy1 = V::sub(fy, fone);
+
+  const F lo = KernelLerp<V>(sx,
+    KernelZ<V>(a, c[0], fx, fy), KernelZ<V>(a, c[1], fx1, fy));
+  const F hi = KernelLerp<V>(sx,
+    KernelZ<V>(a, c[2], fx, fy1), KernelZ<V>(a, c[3], fx1, fy1));
+
+  return KernelLerp<V>(sy, lo, hi);
+} //KernelBilerp
+
+/// Compute one octave of Perlin or Value noise on a vector of points. This is
+/// the vector equivalent of `CPerlinNoise2D::noise()`.
+/// \tparam V Instruction set wrapper class.
+/// \param a Kernel arguments.
+/// \param cx Vector of masked lattice cell X-coordinates.
+/// \param cy Vector of masked lattice cell Y-coordinates.
+/// \param fx Vector of fractional parts of X-coordinates.
+/// \param fy Vector of fractional parts of Y-coordinates.
+/// \return Vector of noise values.
+
+template<class V> 
+inline typename V::F KernelLattice(const KernelArgs& a, typename V::I cx,
+  typename V::I cy, typename V::F fx, typename V::F fy)
+{
+  typename V::I c[4]; //corner hashes
+  KernelCorners<V>(a, cx, cy, c);
+
+  return KernelBilerp<V>(a, c, KernelSpline<V>(fx, a.eSplineType),
+    KernelSpline<V>(fy, a.eSplineType), fx, fy);
+} //KernelLattice
+
+/// Compute one octave of both channels of a Perlin noise warp field on a
+/// vector of points. This is the vector equivalent of
+/// `CPerlinNoise2D::noise2()`. The corners are hashed once for both
+/// channels, and the second channel offsets the hash values by half of
+/// the table size.
+/// \tparam V Instruction set wrapper class.
+/// \param a Kernel arguments.
+/// \param cx Vector of masked lattice cell X-coordinates.
+/// \param cy Vector of masked lattice cell Y-coordinates.
+/// \param fx Vector of fractional parts of X-coordinates.
+/// \param fy Vector of fractional parts of Y-coordinates.
+/// \param v2 [OUT] Vector of noise values for the second channel.
+/// \return Vector of noise values for the first channel.
+
+template<class V> 
+inline typename V::F KernelWarp(const KernelArgs& a, typename V::I cx,
+  typename V::I cy, typename V::F fx, typename V::F fy, typename V::F& v2)
+{
+  typedef typename V::F F; //vector of floats
+  typedef typename V::I I; //vector of 32-bit integers
+
+  const I mask = V::set1i(a.nMask); //table size mask
+  const I half = V::set1i((a.nTableMask + 1) >> 1); //half of table size
+
+  I c[4], d[4]; //corner hashes for each channel
+  KernelCorners<V>(a, cx, cy, c);
+
+  for(int k=0; k<4; k++) //rekey, see CPerlinNoise2D::rekey()
+    d[k] = V::andi(V::addi(c[k], half), mask);
+
+  const F sx = KernelSpline<V>(fx, a.eSplineType); //smoothed x
+  const F sy = KernelSpline<V>(fy, a.eSplineType); //smoothed y
+
+  v2 = KernelBilerp<V>(a, d, sx, sy, fx, fy);
+  return KernelBilerp<V>(a, c, sx, sy, fx, fy);
+} //KernelWarp
+
+/// Get the contribution of one simplex corner, \f$t^4 z\f$ where
+/// \f$t = \max(0, 1/2 - x^2 - y^2)\f$.
+/// \tparam V Instruction set wrapper class.
+/// \param a Kernel arguments.
+/// \param h Vector of corner hash values.
+/// \param x Vector of X-offsets from the corner.
+/// \param y Vector of Y-offsets from the corner.
+/// \return Vector of contributions.
+
+template<class V> 
+inline typename V::F KernelCorner(const KernelArgs& a, typename V::I h,
+  typename V::F x, typename V::F y)
+{
+  typename V::F t = V::sub(V::sub(V::set1(0.5f), V::mul(x, x)), V::mul(y, y));
+  t = V::max(t, V::set1(0.0f)); //no contribution from far corners
+  t = V::mul(t, t);
+  return V::mul(V::mul(t, t), KernelZ<V>(a, h, x, y));
+} //KernelCorner
+
+/// Compute one octave of Simplex noise on a vector of points given in skewed
+/// coordinates. This is the vector equivalent of `CPerlinNoise2D::simplex()`,
+/// except that all three corners are always hashed.
+/// \tparam V Instruction set wrapper class.
+/// \param a Kernel arguments.
+/// \param cx Vector of masked skewed cell X-coordinates.
+/// \param cy Vector of masked skewed cell Y-coordinates.
+/// \param fx Vector of fractional parts of skewed X-coordinates.
+/// \param fy Vector of fractional parts of skewed Y-coordinates.
+/// \return Vector of noise values.
+
+template<class V> 
+inline typename V::F KernelSimplex(const KernelArgs& a, typename V::I cx,
+  typename V::I cy, typename V::F fx, typename V::F fy)
+{
+  typedef typename V::F F; //vector of floats
+  typedef typename V::I I; //vector of 32-bit integers
+
+  const I mask = V::set1i(a.nMask); //table size mask
+  const I one = V::set1i(1); //integer one
+  const F fone = V::set1(1.0f); //float one
+  const F g2 = V::set1(G2); //unskew factor
+
+  //offsets from the three corners in unskewed coordinates
+
+  const F g = V::mul(V::add(fx, fy), g2); //unskew
+  const F x0 = V::sub(fx, g);
+  const F y0 = V::sub(fy, g);
+
+  const I i1 = V::andi(V::cmpgt(fx, fy), one); //1 in lower triangle
+  const I j1 = V::xori(i1, one); //1 in upper triangle
+
+  const F x1 = V::add(V::sub(x0, V::tofloat(i1)), g2);
+  const F y1 = V::add(V::sub(y0, V::tofloat(j1)), g2);
+  const F x2 = V::add(V::sub(x0, fone), V::set1(2.0f*G2));
+  const F y2 = V::add(V::sub(y0, fone), V::set1(2.0f*G2));
+
+  //hash corners, c[k] = perm[(perm[x] + y) & mask]
+
+  const I c0 = KernelHash<V>(a, V::andi(V::addi(KernelHash<V>(a, cx), cy),
+    mask));
+  const I c1 = KernelHash<V>(a, V::andi(V::addi(KernelHash<V>(a,
+    V::andi(V::addi(cx, i1), mask)), V::addi(cy, j1)), mask));
+  const I c2 = KernelHash<V>(a, V::andi(V::addi(KernelHash<V>(a,
+    V::andi(V::addi(cx, one), mask)), V::addi(cy, one)), mask));
+
+  const F n = V::add(V::add(KernelCorner<V>(a, c0, x0, y0),
+    KernelCorner<V>(a, c1, x1, y1)), KernelCorner<V>(a, c2, x2, y2));
+
+  return V::mul(V::set1(70.0f), n);
+} //KernelSimplex
+
+/// Compute one octave of Worley noise on a vector of points. This is the
+/// vector equivalent of `CPerlinNoise2D::worley()`, except that all nine
+/// cells of the neighborhood are always searched. Pruning only skips cells
+/// that cannot change the result, so the results are the same.
+/// \tparam V Instruction set wrapper class.
+/// \param a Kernel arguments.
+/// \param cx Vector of masked lattice cell X-coordinates.
+/// \param cy Vector of masked lattice cell Y-coordinates.
+/// \param fx Vector of fractional parts of X-coordinates.
+/// \param fy Vector of fractional parts of Y-coordinates.
+/// \return Vector of noise values.
+
+template<class V> 
+inline typename V::F KernelWorley(const KernelArgs& a, typename V::I cx,
+  typename V::I cy, typename V::F fx, typename V::F fy)
+{
+  typedef typename V::F F; //vector of floats
+  typedef typename V::I I; //vector of 32-bit integers
+
+  const I mask = V::set1i(a.nMask); //table size mask
+  const I tmask = V::set1i(a.nTableMask); //table size mask
+  const F jitter = V::set1(JITTER); //feature point jitter
+
+  F f1 = V::set1(8.0f); //squared distance to nearest feature point
+  F f2 = V::set1(8.0f); //squared distance to second nearest feature point
+
+  for(int32_t i=-1; i<=1; i++){ //for each column of cells
+    const I px = KernelHash<V>(a, V::andi(V::addi(cx, V::set1i(i)), mask));
+    const F ox = V::set1((float)i + 0.5f); //offset to cell center
+
+    for(int32_t j=-1; j<=1; j++){ //for each cell in the column
+      const I c = KernelHash<V>(a,
+        V::andi(V::addi(px, V::addi(cy, V::set1i(j))), mask)); //cell hash
+
+      const F x = V::gather(a.pTable, V::andi(c, tmask)); //feature offset
+      const F y = V::gather(a.pTable, V::andi(KernelHash<V>(a, c), tmask));
+
+      const F dx = V::sub(V::add(ox, V::mul(jitter, x)), fx);
+      const F dy = V::sub(V::add(V::set1((float)j + 0.5f), V::mul(jitter, y)),
+        fy);
+      const F d = V::add(V::mul(dx, dx), V::mul(dy, dy)); //squared distance
+
+      f2 = V::min(f2, V::max(f1, d));
+      f1 = V::min(f1, d);
+    } //for
+  } //for
+
+  F result; //distance
+
+  switch(a.eWorleyType){
+    case eWorley::F1: result = V::sqrt(f1); break;
+    case eWorley::F2: result = V::sqrt(f2); break;
+    default: result = V::sub(V::sqrt(f2), V::sqrt(f1)); break;
+  } //switch
+
+  result = V::sub(V::mul(V::set1(1.5f), result), V::set1(1.0f));
+  return V::max(V::set1(-1.0f), V::min(result, V::set1(1.0f)));
+} //KernelWorley
+
+/// Transform a vector of octaves for the fractal type. This is the vector
+/// equivalent of `CPerlinNoise2D::fractal()`.
+/// \tparam V Instruction set wrapper class.
+/// \param a Kernel arguments.
+/// \param n Vector of noise values.
+/// \param weight [IN, OUT] Vector of ridged multifractal weights.
+/// \return Vector of transformed noise values.
+
+template<class V> 
+inline typename V::F KernelFractal(const KernelArgs& a, typename V::F n,
+  typename V::F& weight)
+{
+  typedef typename V::F F; //vector of floats
+
+  switch(a.eFractalType){
+    case eFractal::Turbulence: return V::abs(n);
+
+    case eFractal::Billow:
+      return V::sub(V::mul(V::set1(2.0f), V::abs(n)), V::set1(1.0f));
+
+    case eFractal::Ridged: {
+      F s = V::sub(V::set1(1.0f), V::abs(n)); //invert so that ridges are high
+      s = V::mul(s, s); //sharpen ridges
+      s = V::mul(s, weight); //weight by previous octave
+      weight = V::max(V::set1(0.0f),
+        V::min(V::mul(V::set1(2.0f), s), V::set1(1.0f)));
+      return s;
+    } //case
+
+    default: return n;
+  } //switch
+} //KernelFractal
+
+/// The fused batch noise kernel for several configurations that differ only
+/// in their gradient/value tables. For each batch of `V::W` points, the
+/// lattice cells, corner hashes, gradient table indices, and spline weights
+/// of every octave are computed once and kept in registers or on the stack.
+/// Then for each configuration only the table lookups, the interpolation,
+/// and the fractal transform are done. These are the same operations in the
+/// same order as in `BatchNoise()`, so the results are the same as
+/// computing each configuration separately.
+/// \tparam V Instruction set wrapper class.
+/// \param a Kernel arguments.
+
+template<class V> 
+void BatchNoiseFused(const KernelArgs& a){
+  typedef typename V::F F; //vector of floats
+  typedef typename V::I I; //vector of 32-bit integers
+
+  const I mask = V::set1i(a.nMask); //table size mask
+  const I tmask = V::set1i(a.nTableMask); //gradient table size mask
+  const F fone = V::set1(1.0f); //float one
+  const bool bPerlin = a.eNoiseType == eNoise::Perlin; //Perlin, not Value
+
+  F sx[MAXFUSEDOCTAVES], sy[MAXFUSEDOCTAVES]; //smoothed fractional parts
+  F fx[MAXFUSEDOCTAVES], fy[MAXFUSEDOCTAVES]; //fractional parts
+  I gx[MAXFUSEDOCTAVES][4]; //table indices of X gradients or values
+  I gy[MAXFUSEDOCTAVES][4]; //table indices of Y gradients
+
+  for(size_t i=0; i<a.nCount; i+=V::W){
+    I cx = V::loadi(a.pCellX + i); //masked lattice cell x
+    I cy = V::loadi(a.pCellY + i); //masked lattice cell y
+    F x = V::load(a.pFracX + i); //fractional part of x
+    F y = V::load(a.pFracY + i); //fractional part of y
+
+    for(size_t j=0; j<a.nOctaves; j++){ //shared work for each octave
+      I c[4]; //corner hashes
+      KernelCorners<V>(a, cx, cy, c);
+
+      for(int k=0; k<4; k++){ //table indices, see KernelZ()
+        gx[j][k] = V::andi(c[k], tmask);
+        if(bPerlin)gy[j][k] = V::andi(KernelHash<V>(a, c[k]), tmask);
+      } //for
+
+      fx[j] = x; sx[j] = KernelSpline<V>(x, a.eSplineType);
+      fy[j] = y; sy[j] = KernelSpline<V>(y, a.eSplineType);
+
+      //double the frequency as in BatchNoise()
+
+      const F gx2 = V::add(x, x); 
+      const F gy2 = V::add(y, y);
+      const I kx = V::trunc(gx2); //whole part of doubled fraction
+      const I ky = V::trunc(gy2); //whole part of doubled fraction
+
+      x = V::sub(gx2, V::tofloat(kx));
+      y = V::sub(gy2, V::tofloat(ky));
+      cx = V::andi(V::addi(V::addi(cx, cx), kx), mask);
+      cy = V::andi(V::addi(V::addi(cy, cy), ky), mask);
+    } //for
+
+    for(size_t t=0; t<a.nTables; t++){ //for each configuration
+      const float* pTable = a.pTables[t]; //its table
+      F sum = V::set1(0.0f); //for result
+      F weight = V::set1(1.0f); //ridged multifractal weight
+      float amplitude = 1.0f; //octave amplitude
+
+      for(size_t j=0; j<a.nOctaves; j++){ //for each octave
+        const F fx1 = V::sub(fx[j], fone);
+        const F fy1 = V::sub(fy[j], fone);
+        F z[4]; //Z-values at corners
+
+        for(int k=0; k<4; k++){
+          z[k] = V::gather(pTable, gx[j][k]);
+
+          if(bPerlin) //gradient times position
+            z[k] = V::add(V::mul((k & 1)? fx1: fx[j], z[k]),
+              V::mul((k & 2)? fy1: fy[j], V::gather(pTable, gy[j][k])));
+        } //for
+
+        F v = KernelLerp<V>(sy[j], KernelLerp<V>(sx[j], z[0], z[1]),
+          KernelLerp<V>(sx[j], z[2], z[3]));
+
+        v = KernelFractal<V>(a, v, weight);
+        sum = V::add(sum, V::mul(V::set1(amplitude), v));
+        amplitude *= a.fAlpha; //reduce amplitude by lacunarity
+      } //for
+
+      V::store(a.pSum + t*a.nCount + i, sum);
+    } //for
+  } //for
+} //BatchNoiseFused
+
+/// The batch noise kernel. For each batch of `V::W` points, compute each
+/// octave of Perlin, Value, Simplex, or Worley noise using the permutation
+/// hash, transform it for the fractal type, and add it to the sum. For a
+/// warp field, compute both channels of Perlin noise and add them to
+/// their own sums instead. Moving to
+/// the next octave doubles the cell coordinates and fractional parts,
+/// carrying the whole part of the doubled fraction into the cell coordinate.
+/// This is exact and matches what `CPerlinNoise2D::scale()` does for a
+/// persistence of 2. Fused configurations are handed to `BatchNoiseFused()`.
+/// \tparam V Instruction set wrapper class.
+/// \param a Kernel arguments.
+
+template<class V> 
+void BatchNoise(const KernelArgs& a){
+  typedef typename V::F F; //vector of floats
+  typedef typename V::I I; //vector of 32-bit integers
+
+  if(a.pTables != nullptr){ //several tables
+    BatchNoiseFused<V>(a);
+    return;
+  } //if
+
+  const I mask = V::set1i(a.nMask); //table size mask
+
+  for(size_t i=0; i<a.nCount; i+=V::W){
+    I cx = V::loadi(a.pCellX + i); //masked lattice cell x
+    I cy = V::loadi(a.pCellY + i); //masked lattice cell y
+    F fx = V::load(a.pFracX + i); //fractional part of x
+    F fy = V::load(a.pFracY + i); //fractional part of y
+
+    F sum = V::set1(0.0f); //for result
+    F sum2 = V::set1(0.0f); //for second warp channel
+    F weight = V::set1(1.0f); //ridged multifractal weight
+    float amplitude = 1.0f; //octave amplitude
+
+    for(size_t j=0; j<a.nOctaves; j++){ //for each octave
+      F v; //noise for this octave
+
+      if(a.pSum2 != nullptr){ //both channels of a warp field
+        F v2; //noise for the second channel
+        v = KernelWarp<V>(a, cx, cy, fx, fy, v2);
+        sum2 = V::add(sum2, V::mul(V::set1(amplitude), v2));
+      } //if
+
+      else{
+        switch(a.eNoiseType){
+          case eNoise::Simplex: v = KernelSimplex<V>(a, cx, cy, fx, fy); break;
+          case eNoise::Worley:  v = KernelWorley<V>(a, cx, cy, fx, fy);  break;
+          default:              v = KernelLattice<V>(a, cx, cy, fx, fy); break;
+        } //switch
+
+        v = KernelFractal<V>(a, v, weight);
+      } //else
+
+      sum = V::add(sum, V::mul(V::set1(amplitude), v));
+      amplitude *= a.fAlpha; //reduce amplitude by lacunarity
+
+      //double the frequency
+
+      const F gx = V::add(fx, fx); 
+      const F gy = V::add(fy, fy);
+      const I kx = V::trunc(gx); //whole part of doubled fraction
+      const I ky = V::trunc(gy); //whole part of doubled fraction
+
+      fx = V::sub(gx, V::tofloat(kx));
+      fy = V::sub(gy, V::tofloat(ky));
+      cx = V::andi(V::addi(V::addi(cx, cx), kx), mask);
+      cy = V::andi(V::addi(V::addi(cy, cy), ky), mask);
+    } //for
+
+    V::store(a.pSum + i, sum);
+
+    if(a.pSum2 != nullptr)
+      V::store(a.pSum2 + i, sum2);
+  } //for
+} //BatchNoise
+
+#endif //__KERNELTEMPLATE_H__
@@ -0,0 +1,133 @@
+/// \file Kernels.cpp
+///
+/// \brief Code for choosing the instruction set for the batch noise kernels.
+
+// MIT License
+//
+// Copyright (c) 2022 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _MSC_VER
+  #include <intrin.h>
+#else
+  #include <cpuid.h>
+#endif
+
+#include "Kernels.h"
+
+/// Execute the CPUID instruction.
+/// \param leaf CPUID leaf, that is, the value of the EAX register.
+/// \param subleaf CPUID subleaf, that is, the value of the ECX register.
+/// \param r [OUT] Values of EAX, EBX, ECX, and EDX, in that order.
+
+static void CPUID(int leaf, int subleaf, unsigned r[4]){
+#ifdef _MSC_VER
+  __cpuidex((int*)r, leaf, subleaf);
+#else
+  __cpuid_count(leaf, subleaf, r[0], r[1], r[2], r[3]);
+#endif
+} //CPUID
+
+/// Read the extended control register XCR0, which tells us which register
+/// states the operating system saves and restores on a context switch.
+/// This must only be called if the OSXSAVE bit is set by CPUID.
+/// \return The value of XCR0.
+
+static uint64_t XCR0(){
+#ifdef _MSC_VER
+  return _xgetbv(0);
+#else
+  unsigned lo = 0, hi = 0;
+  __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+  return ((uint64_t)hi << 32) | lo;
+#endif
+} //XCR0
+
+/// Test whether the processor and the operating system support an
+/// instruction set. AVX2 requires the OS to save the YMM registers, and
+/// AVX-512 requires it to also save the opmask and ZMM registers.
+/// \param isa Instruction set enumerated type.
+/// \return true if the instruction set can be used.
+
+const bool ISASupported(eISA isa){
+  unsigned r[4] = {0}; //CPUID results
+  CPUID(0, 0, r);
+  const unsigned nMaxLeaf = r[0]; //largest CPUID leaf
+
+  CPUID(1, 0, r);
+  const bool bSSE2    = (r[3] & (1 << 26)) != 0;
+  const bool bOSXSAVE = (r[2] & (1 << 27)) != 0;
+  const bool bAVX     = (r[2] & (1 << 28)) != 0;
+
+  bool bAVX2 = false, bAVX512 = false; //leaf 7 features
+
+  if(nMaxLeaf >= 7){
+    CPUID(7, 0, r);
+    bAVX2   = (r[1] & (1 << 5))  != 0;
+    bAVX512 = (r[1] & (1 << 16)) != 0;
+  } //if
+
+  const uint64_t xcr0 = bOSXSAVE? XCR0(): 0; //OS-saved register state
+  const bool bYMM = (xcr0 & 0x06) == 0x06; //XMM and YMM state
+  const bool bZMM = (xcr0 & 0xE6) == 0xE6; //and opmask and ZMM state
+
+  switch(isa){
+    case eISA::Scalar: return true;
+    case eISA::SSE2:   return bSSE2;
+    case eISA::AVX2:   return bAVX && bAVX2 && bYMM;
+    case eISA::AVX512: return bAVX && bAVX2 && bAVX512 && bZMM;
+    default: return false;
+  } //switch
+} //ISASupported
+
+/// Choose the best instruction set for the batch noise kernels that is
+/// supported by the processor and the operating system. This can be
+/// overridden for testing by setting the environment variable `NOISE_ISA`
+/// to one of `scalar`, `sse2`, `avx2`, or `avx512`. The override is
+/// ignored if the instruction set that it asks for is not supported.
+/// \return The instruction set enumerated type.
+
+const eISA BestISA(){
+  const eISA isa[] = {eISA::AVX512, eISA::AVX2, eISA::SSE2, eISA::Scalar};
+  const char* name[] = {"avx512", "avx2", "sse2", "scalar"};
+
+  char env[16] = {0}; //value of environment variable, if any
+
+#ifdef _MSC_VER
+  size_t len = 0;
+  getenv_s(&len, env, sizeof(env), "NOISE_ISA");
+#else
+  const char* p = getenv("NOISE_ISA");
+  if(p)strncpy(env, p, sizeof(env) - 1);
+#endif
+
+  for(size_t i=0; i<4; i++) //check for override
+    if(strcmp(env, name[i]) == 0 && ISASupported(isa[i]))
+      return isa[i];
+
+  for(size_t i=0; i<4; i++) //best supported
+    if(ISASupported(isa[i]))
+      return isa[i];
+
+  return eISA::Scalar;
+} //BestISA
@@ -0,0 +1,94 @@
+/// \file Kernels.h
+///
+/// \brief Interface for the batch noise kernels.
+
+// MIT License
+//
+// Copyright (c) 2022 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#ifndef __KERNELS_H__
+#define __KERNELS_H__
+
+#include <cstdint>
+#include <cstddef>
+
+#include "Defines.h"
+
+/// \brief Batch noise kernel arguments.
+///
+/// Everything a batch noise kernel needs to compute several octaves of
+/// Perlin or Value noise at a batch of points using the permutation hash
+/// and a persistence of 2. The permutation is either one-level, in which
+/// case `nHiMask` is zero, or two-level, as in `CPerlinNoise2D::hash()`.
+/// Each point is given as its lattice cell masked to the table size together
+/// with its fractional offset within that cell. The arrays must be padded
+/// to a multiple of 16 points. If `pSum2` is not nullptr, then the kernel
+/// computes two channels of Perlin noise for a domain warp field instead,
+/// with no fractal transform. If `pTables` is not nullptr, then the kernel
+/// computes Perlin or Value noise for `nTables` configurations that differ
+/// only in their tables, sharing everything but the table lookups, and the
+/// sums for configuration \f$k\f$ go to `pSum + k*nCount`. This needs at
+/// most `MAXFUSEDOCTAVES` octaves.
+
+struct KernelArgs{
+  const uint32_t* pPerm = nullptr; ///< One-level permutation.
+  const uint32_t* pPermLo = nullptr; ///< Two-level permutation of low bits.
+  const uint32_t* pPermHi = nullptr; ///< Two-level permutation of high bits.
+  const uint32_t* pKeyLo = nullptr; ///< Two-level keys indexed by low bits.
+  const uint32_t* pKeyHi = nullptr; ///< Two-level keys indexed by high bits.
+  const float* pTable = nullptr; ///< Table of gradients or values.
+  int32_t nMask = 0; ///< Mask for values less than the permutation size.
+  int32_t nTableMask = 0; ///< Mask for values less than the table size.
+  int32_t nHiMask = 0; ///< Mask for high bits, zero if one-level.
+  int32_t nBlockBits = 0; ///< Number of low bits.
+
+  eNoise eNoiseType = eNoise::Perlin; ///< Noise type.
+  eSpline eSplineType = eSpline::Cubic; ///< Spline function type.
+  eWorley eWorleyType = eWorley::F1; ///< Worley noise distance.
+  eFractal eFractalType = eFractal::Sum; ///< Octave combination.
+  size_t nOctaves = 0; ///< Number of octaves.
+  float fAlpha = 0.5f; ///< Lacunarity.
+
+  size_t nCount = 0; ///< Number of points, a multiple of 16.
+  const int32_t* pCellX = nullptr; ///< Masked X-coordinates of lattice cells.
+  const int32_t* pCellY = nullptr; ///< Masked Y-coordinates of lattice cells.
+  const float* pFracX = nullptr; ///< Fractional parts of X-coordinates.
+  const float* pFracY = nullptr; ///< Fractional parts of Y-coordinates.
+
+  float* pSum = nullptr; ///< [OUT] Octave sums, not yet normalized.
+  float* pSum2 = nullptr; ///< [OUT] Second warp channel sums, or nullptr.
+
+  const float* const* pTables = nullptr; ///< Fused tables, or nullptr.
+  size_t nTables = 0; ///< Number of fused configurations.
+}; //KernelArgs
+
+const size_t MAXFUSEDOCTAVES = 16; ///< Maximum octaves when fused.
+
+typedef void (*NoiseKernel)(const KernelArgs&); ///< Batch noise kernel.
+
+void NoiseKernelSSE2(const KernelArgs&); ///< SSE2 batch noise kernel.
+void NoiseKernelAVX2(const KernelArgs&); ///< AVX2 batch noise kernel.
+void NoiseKernelAVX512(const KernelArgs&); ///< AVX-512 batch noise kernel.
+
+const bool ISASupported(eISA); ///< Instruction set support test.
+const eISA BestISA(); ///< Best supported instruction set.
+
+#endif //__KERNELS_H__
@@ -0,0 +1,81 @@
+/// \file KernelsAVX2.cpp
+///
+/// \brief The AVX2 batch noise kernel. This file must be compiled with
+/// AVX2 code generation enabled, and the kernel must only be called
+/// on processors that support AVX2.
+
+// MIT License
+//
+// Copyright (c) 2022 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include <immintrin.h>
+
+#include "KernelTemplate.h"
+
+/// \brief AVX2 wrappers.
+///
+/// Static inline wrappers for the AVX2 intrinsics used by `BatchNoise()`,
+/// operating on 8 lanes. Permutation and table lookups use the
+/// AVX2 gather instructions.
+
+class CAVX2{
+  public:
+    typedef __m256 F; ///< Vector of floats.
+    typedef __m256i I; ///< Vector of 32-bit integers.
+    static const size_t W = 8; ///< Number of lanes.
+
+    static inline F load(const float* p){return _mm256_loadu_ps(p);}
+    static inline I loadi(const int32_t* p){return _mm256_loadu_si256((const __m256i*)p);}
+    static inline void store(float* p, F x){_mm256_storeu_ps(p, x);}
+    static inline F set1(float x){return _mm256_set1_ps(x);}
+    static inline I set1i(int32_t x){return _mm256_set1_epi32(x);}
+
+    static inline F add(F a, F b){return _mm256_add_ps(a, b);}
+    static inline F sub(F a, F b){return _mm256_sub_ps(a, b);}
+    static inline F mul(F a, F b){return _mm256_mul_ps(a, b);}
+    static inline F min(F a, F b){return _mm256_min_ps(a, b);}
+    static inline F max(F a, F b){return _mm256_max_ps(a, b);}
+    static inline F sqrt(F x){return _mm256_sqrt_ps(x);}
+    static inline F abs(F x){return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);}
+    static inline I addi(I a, I b){return _mm256_add_epi32(a, b);}
+    static inline I andi(I a, I b){return _mm256_and_si256(a, b);}
+    static inline I xori(I a, I b){return _mm256_xor_si256(a, b);}
+    static inline I slli(I a, int n){return _mm256_sll_epi32(a, _mm_cvtsi32_si128(n));}
+    static inline I srli(I a, int n){return _mm256_srl_epi32(a, _mm_cvtsi32_si128(n));}
+    static inline I trunc(F x){return _mm256_cvttps_epi32(x);}
+    static inline F tofloat(I x){return _mm256_cvtepi32_ps(x);}
+    static inline I cmpgt(F a, F b){return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_GT_OQ));}
+
+    static inline I gather(const uint32_t* p, I h){
+      return _mm256_i32gather_epi32((const int*)p, h, 4);
+    } //gather
+
+    static inline F gather(const float* p, I h){
+      return _mm256_i32gather_ps(p, h, 4);
+    } //gather
+}; //CAVX2
+
+/// AVX2 batch noise kernel.
+/// \param a Kernel arguments.
+
+void NoiseKernelAVX2(const KernelArgs& a){
+  BatchNoise<CAVX2>(a);
+} //NoiseKernelAVX2
@@ -0,0 +1,85 @@
+/// \file KernelsAVX512.cpp
+///
+/// \brief The AVX-512 batch noise kernel. This file must be compiled with
+/// AVX-512 code generation enabled, and the kernel must only be called
+/// on processors that support AVX-512F.
+
+// MIT License
+//
+// Copyright (c) 2022 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include <immintrin.h>
+
+#include "KernelTemplate.h"
+
+/// \brief AVX-512 wrappers.
+///
+/// Static inline wrappers for the AVX-512F intrinsics used by
+/// `BatchNoise()`, operating on 16 lanes. Permutation and table lookups
+/// use the AVX-512 gather instructions.
+
+class CAVX512{
+  public:
+    typedef __m512 F; ///< Vector of floats.
+    typedef __m512i I; ///< Vector of 32-bit integers.
+    static const size_t W = 16; ///< Number of lanes.
+
+    static inline F load(const float* p){return _mm512_loadu_ps(p);}
+    static inline I loadi(const int32_t* p){return _mm512_loadu_si512(p);}
+    static inline void store(float* p, F x){_mm512_storeu_ps(p, x);}
+    static inline F set1(float x){return _mm512_set1_ps(x);}
+    static inline I set1i(int32_t x){return _mm512_set1_epi32(x);}
+
+    static inline F add(F a, F b){return _mm512_add_ps(a, b);}
+    static inline F sub(F a, F b){return _mm512_sub_ps(a, b);}
+    static inline F mul(F a, F b){return _mm512_mul_ps(a, b);}
+    static inline F min(F a, F b){return _mm512_min_ps(a, b);}
+    static inline F max(F a, F b){return _mm512_max_ps(a, b);}
+    static inline F sqrt(F x){return _mm512_sqrt_ps(x);}
+    static inline F abs(F x){return _mm512_abs_ps(x);}
+    static inline I addi(I a, I b){return _mm512_add_epi32(a, b);}
+    static inline I andi(I a, I b){return _mm512_and_si512(a, b);}
+    static inline I xori(I a, I b){return _mm512_xor_si512(a, b);}
+    static inline I slli(I a, int n){return _mm512_sll_epi32(a, _mm_cvtsi32_si128(n));}
+    static inline I srli(I a, int n){return _mm512_srl_epi32(a, _mm_cvtsi32_si128(n));}
+    static inline I trunc(F x){return _mm512_cvttps_epi32(x);}
+    static inline F tofloat(I x){return _mm512_cvtepi32_ps(x);}
+
+    static inline I cmpgt(F a, F b){
+      return _mm512_maskz_mov_epi32(_mm512_cmp_ps_mask(a, b, _CMP_GT_OQ),
+        _mm512_set1_epi32(-1));
+    } //cmpgt
+
+    static inline I gather(const uint32_t* p, I h){
+      return _mm512_i32gather_epi32(h, p, 4);
+    } //gather
+
+    static inline F gather(const float* p, I h){
+      return _mm512_i32gather_ps(h, p, 4);
+    } //gather
+}; //CAVX512
+
+/// AVX-512 batch noise kernel.
+/// \param a Kernel arguments.
+
+void NoiseKernelAVX512(const KernelArgs& a){
+  BatchNoise<CAVX512>(a);
+} //NoiseKernelAVX512
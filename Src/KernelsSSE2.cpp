@@ -0,0 +1,81 @@
+/// \file KernelsSSE2.cpp
+///
+/// \brief The SSE2 batch noise kernel.
+
+// MIT License
+//
+// Copyright (c) 2022 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include <emmintrin.h>
+
+#include "KernelTemplate.h"
+
+/// \brief SSE2 wrappers.
+///
+/// Static inline wrappers for the SSE2 intrinsics used by `BatchNoise()`,
+/// operating on 4 lanes. SSE2 has no gather instructions, so gathers are
+/// done one lane at a time.
+
+class CSSE2{
+  public:
+    typedef __m128 F; ///< Vector of floats.
+    typedef __m128i I; ///< Vector of 32-bit integers.
+    static const size_t W = 4; ///< Number of lanes.
+
+    static inline F load(const float* p){return _mm_loadu_ps(p);}
+    static inline I loadi(const int32_t* p){return _mm_loadu_si128((const __m128i*)p);}
+    static inline void store(float* p, F x){_mm_storeu_ps(p, x);}
+    static inline F set1(float x){return _mm_set1_ps(x);}
+    static inline I set1i(int32_t x){return _mm_set1_epi32(x);}
+
+    static inline F add(F a, F b){return _mm_add_ps(a, b);}
+    static inline F sub(F a, F b){return _mm_sub_ps(a, b);}
+    static inline F mul(F a, F b){return _mm_mul_ps(a, b);}
+    static inline F min(F a, F b){return _mm_min_ps(a, b);}
+    static inline F max(F a, F b){return _mm_max_ps(a, b);}
+    static inline F sqrt(F x){return _mm_sqrt_ps(x);}
+    static inline F abs(F x){return _mm_andnot_ps(_mm_set1_ps(-0.0f), x);}
+    static inline I addi(I a, I b){return _mm_add_epi32(a, b);}
+    static inline I andi(I a, I b){return _mm_and_si128(a, b);}
+    static inline I xori(I a, I b){return _mm_xor_si128(a, b);}
+    static inline I slli(I a, int n){return _mm_sll_epi32(a, _mm_cvtsi32_si128(n));}
+    static inline I srli(I a, int n){return _mm_srl_epi32(a, _mm_cvtsi32_si128(n));}
+    static inline I trunc(F x){return _mm_cvttps_epi32(x);}
+    static inline F tofloat(I x){return _mm_cvtepi32_ps(x);}
+    static inline I cmpgt(F a, F b){return _mm_castps_si128(_mm_cmpgt_ps(a, b));}
+
+    static inline I gather(const uint32_t* p, I h){
+      alignas(16) int32_t n[4]; _mm_store_si128((__m128i*)n, h);
+      return _mm_set_epi32(p[n[3]], p[n[2]], p[n[1]], p[n[0]]);
+    } //gather
+
+    static inline F gather(const float* p, I h){
+      alignas(16) int32_t n[4]; _mm_store_si128((__m128i*)n, h);
+      return _mm_set_ps(p[n[3]], p[n[2]], p[n[1]], p[n[0]]);
+    } //gather
+}; //CSSE2
+
+/// SSE2 batch noise kernel.
+/// \param a Kernel arguments.
+
+void NoiseKernelSSE2(const KernelArgs& a){
+  BatchNoise<CSSE2>(a);
+} //NoiseKernelSSE2
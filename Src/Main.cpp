@@ -59,6 +59,20 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam){
       g_pMain->OnPaint();
       return 0;
 
+    case WM_TIMER: //time for the next frame of animation
+      g_pMain->NextFrame();
+      InvalidateRect(hWnd, nullptr, FALSE);
+      return 0;
+
+    case WM_MOUSEWHEEL: { //zoom about the mouse cursor
+      POINT pt = {GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam)}; //screen coords
+      ScreenToClient(hWnd, &pt); //client coords
+      
+      if(g_pMain->ZoomClient(GET_WHEEL_DELTA_WPARAM(wParam) > 0, pt.x, pt.y))
+        InvalidateRect(hWnd, nullptr, FALSE);
+    } //case
+    return 0;
+
     //menu bar ---------------------------------------------------
  
     case WM_COMMAND: //user has selected a command from the menu
@@ -77,6 +91,54 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam){
             L"Properties", MB_ICONINFORMATION | MB_OK);
           break;
 
+        case IDM_FILE_BENCH: //time the noise generator
+          SetCursor(LoadCursor(nullptr, IDC_WAIT));
+          MessageBox(nullptr, g_pMain->Benchmark().c_str(), 
+            L"Benchmark", MB_ICONINFORMATION | MB_OK);
+          break;
+
+        case IDM_FILE_ANIM: { //save numbered animation frames
+          std::wstring wstrFileName; //file name for first frame
+
+          if(SUCCEEDED(GetPNGFileName(hWnd, g_pMain->GetFileName(),
+            wstrFileName)))
+          {
+            SetCursor(LoadCursor(nullptr, IDC_WAIT));
+            MessageBox(nullptr, g_pMain->ExportAnimation(wstrFileName).c_str(),
+              L"Export Animation", MB_ICONINFORMATION | MB_OK);
+            InvalidateRect(hWnd, nullptr, FALSE);
+          } //if
+        } //case
+        break;
+
+        case IDM_FILE_GOLDEN: { //save golden images for regression tests
+          std::wstring wstrFileName; //golden file name
+
+          if(SUCCEEDED(GetGoldenFileName(hWnd, true, wstrFileName))){
+            SetCursor(LoadCursor(nullptr, IDC_WAIT));
+            MessageBox(nullptr, g_pMain->SaveGolden(wstrFileName).c_str(),
+              L"Save Golden Images", MB_ICONINFORMATION | MB_OK);
+          } //if
+        } //case
+        break;
+
+        case IDM_FILE_CHECK: { //check against golden images
+          std::wstring wstrFileName; //golden file name
+
+          if(SUCCEEDED(GetGoldenFileName(hWnd, false, wstrFileName))){
+            SetCursor(LoadCursor(nullptr, IDC_WAIT));
+            MessageBox(nullptr, g_pMain->CheckGolden(wstrFileName).c_str(),
+              L"Check Golden Images", MB_ICONINFORMATION | MB_OK);
+          } //if
+        } //case
+        break;
+
+        case IDM_FILE_FUZZ: //differential fuzzing of fast paths
+          SetCursor(LoadCursor(nullptr, IDC_WAIT));
+          MessageBox(nullptr, g_pMain->Fuzz().c_str(), 
+            L"Fuzz Kernels", MB_ICONINFORMATION | MB_OK);
+          break;
+
         case IDM_FILE_QUIT: //so long, farewell, auf weidersehn, goodbye!
           SendMessage(hWnd, WM_CLOSE, 0, 0);
           break;
@@ -93,18 +155,35 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam){
           InvalidateRect(hWnd, nullptr, FALSE);
           break;
 
+        case IDM_GENERATE_SIMPLEXNOISE:
+          g_pMain->GenerateNoiseBitmap(eNoise::Simplex);
+          InvalidateRect(hWnd, nullptr, FALSE);
+          break;
+
+        case IDM_GENERATE_WORLEYNOISE:
+          g_pMain->GenerateNoiseBitmap(eNoise::Worley);
+          InvalidateRect(hWnd, nullptr, FALSE);
+          break;
+
         case IDM_GENERATE_RANDOMIZE:
           g_pMain->Randomize();
           InvalidateRect(hWnd, nullptr, FALSE);
           break;
 
+        case IDM_GENERATE_SEARCH: //search for a seed that hits targets
+          SetCursor(LoadCursor(nullptr, IDC_WAIT));
+          MessageBox(nullptr, g_pMain->SearchSeeds().c_str(), 
+            L"Search Seeds", MB_ICONINFORMATION | MB_OK);
+          InvalidateRect(hWnd, nullptr, FALSE);
+          break;
+
         case IDM_GENERATE_JUMP:
           g_pMain->Jump();
           InvalidateRect(hWnd, nullptr, FALSE);
           break;
 
         case IDM_GENERATE_RESETORIGIN:
-          g_pMain->Jump(0.0f, 0.0f);
+          g_pMain->Jump(0.0, 0.0);
           InvalidateRect(hWnd, nullptr, FALSE);
           break;
 
@@ -169,6 +248,16 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam){
           InvalidateRect(hWnd, nullptr, FALSE);
           break;
 
+        case IDM_HASH_FREE:
+          g_pMain->SetHash(eHash::Stateless);
+          InvalidateRect(hWnd, nullptr, FALSE);
+          break;
+
+        case IDM_HASH_COPRIME:
+          g_pMain->SetHash(eHash::Coprime);
+          InvalidateRect(hWnd, nullptr, FALSE);
+          break;
+
         //spline function menu ------------------------------------------------
 
         case IDM_SPLINE_NONE:
@@ -186,6 +275,45 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam){
           InvalidateRect(hWnd, nullptr, FALSE);
           break;
 
+        //Worley menu -----------------------------------------------------
+
+        case IDM_WORLEY_F1:
+          g_pMain->SetWorley(eWorley::F1);
+          InvalidateRect(hWnd, nullptr, FALSE);
+          break;
+
+        case IDM_WORLEY_F2:
+          g_pMain->SetWorley(eWorley::F2);
+          InvalidateRect(hWnd, nullptr, FALSE);
+          break;
+
+        case IDM_WORLEY_F2F1:
+          g_pMain->SetWorley(eWorley::F2MinusF1);
+          InvalidateRect(hWnd, nullptr, FALSE);
+          break;
+
+        //fractal menu ----------------------------------------------------
+
+        case IDM_FRACTAL_SUM:
+          g_pMain->SetFractal(eFractal::Sum);
+          InvalidateRect(hWnd, nullptr, FALSE);
+          break;
+
+        case IDM_FRACTAL_TURBULENCE:
+          g_pMain->SetFractal(eFractal::Turbulence);
+          InvalidateRect(hWnd, nullptr, FALSE);
+          break;
+
+        case IDM_FRACTAL_BILLOW:
+          g_pMain->SetFractal(eFractal::Billow);
+          InvalidateRect(hWnd, nullptr, FALSE);
+          break;
+
+        case IDM_FRACTAL_RIDGED:
+          g_pMain->SetFractal(eFractal::Ridged);
+          InvalidateRect(hWnd, nullptr, FALSE);
+          break;
+
         //settings menu ---------------------------------------------------
 
         case IDM_SETTINGS_OCTAVE_UP:
@@ -223,6 +351,25 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam){
           InvalidateRect(hWnd, nullptr, FALSE);
           break;
 
+        case IDM_SETTINGS_FIXED:
+          g_pMain->ToggleFixedPoint();
+          InvalidateRect(hWnd, nullptr, FALSE);
+          break;
+
+        case IDM_SETTINGS_CULL:
+          g_pMain->ToggleCullOctaves();
+          InvalidateRect(hWnd, nullptr, FALSE);
+          break;
+
+        case IDM_SETTINGS_WARP:
+          g_pMain->ToggleDomainWarp();
+          InvalidateRect(hWnd, nullptr, FALSE);
+          break;
+
+        case IDM_SETTINGS_ANIMATE:
+          g_pMain->ToggleAnimation();
+          break;
+
         //help menu ---------------------------------------------------
 
         case IDM_HELP_HELP:
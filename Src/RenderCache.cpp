@@ -0,0 +1,255 @@
+/// \file RenderCache.cpp
+///
+/// \brief Code for the on-disk render cache.
+
+// MIT License
+//
+// Copyright (c) 2022 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include <algorithm>
+#include <fstream>
+
+#include "Includes.h"
+#include "RenderCache.h"
+
+/// Load the index from the cache folder, if there is one.
+/// \param wstrFolder Cache folder, ending in a path separator.
+/// \param nBudget Maximum total size of cached files in bytes.
+
+CRenderCache::CRenderCache(const std::wstring& wstrFolder, uint64_t nBudget):
+  m_wstrFolder(wstrFolder), m_nBudget(nBudget)
+{
+  LoadIndex();
+} //constructor
+
+/// Hash a key using 64-bit FNV-1a over its characters.
+/// \param wstrKey Key.
+/// \return Hash of the key.
+
+const uint64_t CRenderCache::Hash(const std::wstring& wstrKey) const{
+  uint64_t h = 0xCBF29CE484222325ULL; //FNV-1a offset basis
+
+  for(const wchar_t c: wstrKey)
+    h = (h ^ (uint64_t)c)*0x100000001B3ULL; //FNV-1a prime
+
+  return h;
+} //Hash
+
+/// Get the path of the file for a hash, which is the hash in hexadecimal.
+/// \param nHash Hash of a key.
+/// \return File path.
+
+const std::wstring CRenderCache::GetPath(uint64_t nHash) const{
+  wchar_t buf[17]; //hexadecimal digits
+  swprintf(buf, 17, L"%016llX", (unsigned long long)nHash);
+  return m_wstrFolder + buf + L".bin";
+} //GetPath
+
+/// Find the index entry for a hash.
+/// \param nHash Hash of a key.
+/// \return Pointer to the index entry, nullptr if there isn't one.
+
+CacheEntry* CRenderCache::Find(uint64_t nHash){
+  for(CacheEntry& e: m_vEntry)
+    if(e.nHash == nHash)return &e;
+
+  return nullptr;
+} //Find
+
+/// Delete the file for a hash and remove its index entry.
+/// \param nHash Hash of a key.
+
+void CRenderCache::Remove(uint64_t nHash){
+  const auto p = std::find_if(m_vEntry.begin(), m_vEntry.end(),
+    [&](const CacheEntry& e){return e.nHash == nHash;});
+
+  if(p != m_vEntry.end()){
+    DeleteFileW(GetPath(nHash).c_str());
+    m_nBytes -= p->nBytes;
+    m_vEntry.erase(p);
+  } //if
+} //Remove
+
+/// Delete the least recently used files until the total size is within the
+/// budget.
+
+void CRenderCache::Evict(){
+  while(m_nBytes > m_nBudget && !m_vEntry.empty()){
+    const auto lru = std::min_element(m_vEntry.begin(), m_vEntry.end(),
+      [](const CacheEntry& a, const CacheEntry& b){
+        return a.nLastUse < b.nLastUse;});
+    Remove(lru->nHash);
+  } //while
+} //Evict
+
+/// Load the index from the file `index.bin` in the cache folder. If there
+/// is no index or it is damaged, then the cache starts out empty. The number
+/// of entries in the header must match the size of the file, so a damaged
+/// header cannot make it allocate a huge index, and each entry is checked
+/// as it is read. If the budget has shrunk since the index was saved, then
+/// the least recently used files are deleted until it is met.
+
+void CRenderCache::LoadIndex(){
+  std::ifstream s((m_wstrFolder + L"index.bin").c_str(), std::ios::binary);
+  uint64_t header[2] = {0}; //tag and number of entries
+  s.read((char*)header, sizeof(header));
+
+  m_vEntry.clear();
+  m_nBytes = m_nClock = 0;
+
+  if(!s || header[0] != 0x5845444E49524E56ULL)return; //"VNRINDEX"
+
+  s.seekg(0, std::ios::end);
+  const uint64_t nFileBytes = (uint64_t)s.tellg(); //size of index file
+  s.seekg(sizeof(header), std::ios::beg);
+
+  if(!s || header[1] != (nFileBytes - sizeof(header))/sizeof(CacheEntry) ||
+    (nFileBytes - sizeof(header))%sizeof(CacheEntry) != 0)
+      return; //wrong number of entries for file size
+
+  m_vEntry.reserve((size_t)header[1]);
+
+  for(uint64_t i=0; i<header[1]; i++){
+    CacheEntry e; //index entry
+    s.read((char*)&e, sizeof(CacheEntry));
+
+    if(!s || e.nBytes > m_nBudget || Find(e.nHash) != nullptr){ //damaged
+      m_vEntry.clear();
+      m_nBytes = m_nClock = 0;
+      return;
+    } //if
+
+    m_vEntry.push_back(e);
+    m_nBytes += e.nBytes;
+    if(e.nLastUse > m_nClock)m_nClock = e.nLastUse; //latest use
+  } //for
+
+  if(m_nBytes > m_nBudget){ //budget has shrunk
+    Evict();
+    SaveIndex();
+  } //if
+} //LoadIndex
+
+/// Save the index to the file `index.bin` in the cache folder. Several
+/// instances of the viewer may share the cache folder, so the index is
+/// written to a temporary file whose name includes the process id and then
+/// moved over `index.bin`, which replaces it in one step. Another instance
+/// therefore sees either the old index or the new one, never part of one.
+
+void CRenderCache::SaveIndex() const{
+  const std::wstring wstrIndex = m_wstrFolder + L"index.bin"; //index file
+  const std::wstring wstrTemp = m_wstrFolder + L"index." +
+    std::to_wstring(GetCurrentProcessId()) + L".tmp"; //temporary file
+
+  std::ofstream s(wstrTemp.c_str(), std::ios::binary);
+  const uint64_t header[2] = {0x5845444E49524E56ULL, m_vEntry.size()};
+
+  s.write((const char*)header, sizeof(header));
+  s.write((const char*)m_vEntry.data(), m_vEntry.size()*sizeof(CacheEntry));
+  s.close();
+
+  if(!s || !MoveFileExW(wstrTemp.c_str(), wstrIndex.c_str(),
+    MOVEFILE_REPLACE_EXISTING))
+      DeleteFileW(wstrTemp.c_str()); //keep the old index
+} //SaveIndex
+
+/// Look up a render. The file must hold exactly the same key and number of
+/// values, otherwise it is a miss.
+/// \param wstrKey Key.
+/// \param p [OUT] Array of noise values, unchanged on a miss.
+/// \param n Number of noise values.
+/// \return true on a hit.
+
+const bool CRenderCache::Get(const std::wstring& wstrKey, float* p, size_t n){
+  const uint64_t nHash = Hash(wstrKey); //hash of key
+  CacheEntry* pEntry = Find(nHash); //index entry
+  if(pEntry == nullptr)return false;
+
+  std::ifstream s(GetPath(nHash).c_str(), std::ios::binary); //cached file
+  uint64_t header[2] = {0}; //key length and number of values
+  s.read((char*)header, sizeof(header));
+
+  std::wstring wstr(s? (size_t)header[0]: 0, L' '); //key from file
+  if(s && header[0] == wstrKey.size())
+    s.read((char*)&wstr[0], wstr.size()*sizeof(wchar_t));
+
+  if(!s || wstr != wstrKey || header[1] != n){ //wrong key or size
+    s.close();
+    Remove(nHash);
+    SaveIndex();
+    return false;
+  } //if
+
+  std::vector<float> v(n); //so that p is unchanged if the read fails
+  s.read((char*)v.data(), n*sizeof(float));
+
+  if(!s){ //file is damaged
+    s.close();
+    Remove(nHash);
+    SaveIndex();
+    return false;
+  } //if
+
+  std::copy(v.begin(), v.end(), p);
+  pEntry->nLastUse = ++m_nClock;
+  SaveIndex();
+
+  return true;
+} //Get
+
+/// Store a render, then delete the least recently used files until the
+/// total size is within the budget. A render that is bigger than the budget
+/// on its own is not stored.
+/// \param wstrKey Key.
+/// \param p Array of noise values.
+/// \param n Number of noise values.
+
+void CRenderCache::Put(const std::wstring& wstrKey, const float* p, size_t n){
+  const uint64_t nHash = Hash(wstrKey); //hash of key
+  const uint64_t header[2] = {wstrKey.size(), n}; //key length, number of values
+  const uint64_t nBytes = sizeof(header) + wstrKey.size()*sizeof(wchar_t) +
+    n*sizeof(float); //file size
+
+  if(nBytes > m_nBudget)return; //too big
+
+  Remove(nHash); //any older file with this hash
+
+  std::ofstream s(GetPath(nHash).c_str(), std::ios::binary); //cache file
+  s.write((const char*)header, sizeof(header));
+  s.write((const char*)wstrKey.data(), wstrKey.size()*sizeof(wchar_t));
+  s.write((const char*)p, n*sizeof(float));
+  s.close();
+
+  if(!s){ //disk full or folder missing
+    DeleteFileW(GetPath(nHash).c_str());
+    return;
+  } //if
+
+  CacheEntry e; //index entry
+  e.nHash = nHash;
+  e.nBytes = nBytes;
+  e.nLastUse = ++m_nClock;
+  m_vEntry.push_back(e);
+  m_nBytes += nBytes;
+
+  Evict();
+  SaveIndex();
+} //Put
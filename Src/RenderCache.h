@@ -0,0 +1,77 @@
+/// \file RenderCache.h
+///
+/// \brief Interface for the on-disk render cache.
+
+// MIT License
+//
+// Copyright (c) 2022 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#ifndef __RENDERCACHE_H__
+#define __RENDERCACHE_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// \brief Render cache index entry.
+
+struct CacheEntry{
+  uint64_t nHash = 0; ///< Hash of the key, which is also the file name.
+  uint64_t nBytes = 0; ///< Size of the file in bytes.
+  uint64_t nLastUse = 0; ///< Time of last use, in cache operations.
+}; //CacheEntry
+
+/// \brief On-disk render cache.
+///
+/// A content-addressed cache of rendered arrays of noise values that
+/// persists between sessions. The key is a string that encodes the complete
+/// state of the noise generator and the render (see
+/// `CMain::GetCacheKey()`), and each array is stored in a file in the cache
+/// folder named after a 64-bit hash of the key. The key itself is stored in
+/// the file too, so a hash collision is a miss rather than wrong noise. An
+/// index file records the size and time of last use of each file, and the
+/// least recently used files are deleted whenever the total size exceeds
+/// a budget.
+
+class CRenderCache{
+  private:
+    std::wstring m_wstrFolder; ///< Cache folder, ending in a separator.
+    uint64_t m_nBudget = 0; ///< Maximum total size of files in bytes.
+    uint64_t m_nBytes = 0; ///< Total size of files in bytes.
+    uint64_t m_nClock = 0; ///< Number of cache operations so far.
+    std::vector<CacheEntry> m_vEntry; ///< Index.
+
+    const uint64_t Hash(const std::wstring&) const; ///< Hash a key.
+    const std::wstring GetPath(uint64_t) const; ///< Get file path for a hash.
+    CacheEntry* Find(uint64_t); ///< Find an index entry.
+    void Remove(uint64_t); ///< Remove a file and its index entry.
+    void Evict(); ///< Remove least recently used files over budget.
+    void LoadIndex(); ///< Load the index.
+    void SaveIndex() const; ///< Save the index.
+
+  public:
+    CRenderCache(const std::wstring&, uint64_t); ///< Constructor.
+
+    const bool Get(const std::wstring&, float*, size_t); ///< Look up a render.
+    void Put(const std::wstring&, const float*, size_t); ///< Store a render.
+}; //CRenderCache
+
+#endif //__RENDERCACHE_H__
@@ -0,0 +1,372 @@
+/// \file Spectrum.cpp
+///
+/// \brief Code for the power spectrum analyzer.
+
+// MIT License
+//
+// Copyright (c) 2022 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "Spectrum.h"
+
+/// Allocate the power spectrum and the tables used by the FFT.
+/// \param n Tile width, rounded up to a power of 2 if it isn't one.
+
+CSpectrum::CSpectrum(size_t n){
+  m_nSize = 2;
+  m_nLog = 1;
+
+  while(m_nSize < n){
+    m_nSize <<= 1;
+    m_nLog++;
+  } //while
+
+  const double pi = 3.14159265358979323846; //pi
+
+  m_dPower = new double[m_nSize*m_nSize];
+  m_dCos = new double[m_nSize/2];
+  m_dSin = new double[m_nSize/2];
+  m_dWindow = new double[m_nSize];
+  m_nReverse = new size_t[m_nSize];
+
+  for(size_t i=0; i<m_nSize/2; i++){ //twiddle factors
+    m_dCos[i] = cos(2.0*pi*i/m_nSize);
+    m_dSin[i] = -sin(2.0*pi*i/m_nSize);
+  } //for
+
+  for(size_t i=0; i<m_nSize; i++){
+    m_dWindow[i] = 0.5 - 0.5*cos(2.0*pi*i/m_nSize);
+    m_nReverse[i] = 0;
+
+    for(size_t j=0; j<m_nLog; j++) //reverse the bits of i
+      if(i & (1ULL << j))
+        m_nReverse[i] |= 1ULL << (m_nLog - 1 - j);
+  } //for
+
+  Clear();
+} //constructor
+
+/// Delete the power spectrum and tables.
+
+CSpectrum::~CSpectrum(){
+  delete [] m_dPower;
+  delete [] m_dCos;
+  delete [] m_dSin;
+  delete [] m_dWindow;
+  delete [] m_nReverse;
+} //destructor
+
+/// Clear the power spectrum.
+
+void CSpectrum::Clear(){
+  std::fill(m_dPower, m_dPower + m_nSize*m_nSize, 0.0);
+  m_nTiles = 0;
+} //Clear
+
+/// In-place iterative radix-2 decimation in time FFT of `m_nSize` complex
+/// values spaced a given distance apart.
+/// \param re [IN, OUT] Real parts.
+/// \param im [IN, OUT] Imaginary parts.
+/// \param stride Distance between values.
+
+void CSpectrum::FFT(double* re, double* im, size_t stride) const{
+  for(size_t i=0; i<m_nSize; i++){ //bit-reversal permutation
+    const size_t j = m_nReverse[i]; //where i goes
+
+    if(i < j){
+      std::swap(re[i*stride], re[j*stride]);
+      std::swap(im[i*stride], im[j*stride]);
+    } //if
+  } //for
+
+  for(size_t len=2; len<=m_nSize; len<<=1){ //butterflies of this length
+    const size_t step = m_nSize/len; //twiddle factor step
+
+    for(size_t i=0; i<m_nSize; i+=len)
+      for(size_t k=0; k<len/2; k++){
+        const size_t a = (i + k)*stride; //top of butterfly
+        const size_t b = (i + k + len/2)*stride; //bottom of butterfly
+        const double c = m_dCos[k*step], s = m_dSin[k*step]; //twiddle factor
+        const double tr = re[b]*c - im[b]*s; //product with twiddle factor
+        const double ti = re[b]*s + im[b]*c;
+
+        re[b] = re[a] - tr; im[b] = im[a] - ti;
+        re[a] += tr; im[a] += ti;
+      } //for
+  } //for
+} //FFT
+
+/// Transform every \f$n\f$-th row of a tile starting at a given row.
+/// \param re [IN, OUT] Real parts, row-major.
+/// \param im [IN, OUT] Imaginary parts, row-major.
+/// \param first First row.
+/// \param n Distance between rows.
+
+void CSpectrum::FFTRows(double* re, double* im, size_t first, size_t n) const{
+  for(size_t j=first; j<m_nSize; j+=n)
+    FFT(&re[j*m_nSize], &im[j*m_nSize], 1);
+} //FFTRows
+
+/// Transform every \f$n\f$-th column of a tile starting at a given column.
+/// \param re [IN, OUT] Real parts, row-major.
+/// \param im [IN, OUT] Imaginary parts, row-major.
+/// \param first First column.
+/// \param n Distance between columns.
+
+void CSpectrum::FFTColumns(double* re, double* im, size_t first, size_t n)
+  const
+{
+  for(size_t i=first; i<m_nSize; i+=n)
+    FFT(&re[i], &im[i], m_nSize);
+} //FFTColumns
+
+/// Add the power spectrum of a tile of values. The rows are transformed and
+/// then the columns, each shared out among the threads.
+/// Each thread works on its own rows or columns, so no locks are needed.
+/// \param p Array of `GetSize()` by `GetSize()` values, row-major.
+/// \param nThreads Number of threads.
+
+void CSpectrum::Add(const float* p, size_t nThreads){
+  const size_t n = m_nSize*m_nSize; //number of values
+  nThreads = std::max<size_t>(1, std::min(nThreads, m_nSize));
+
+  double mean = 0.0; //mean value
+
+  for(size_t i=0; i<n; i++)
+    mean += p[i];
+
+  mean /= n;
+
+  double* re = new double[n]; //real parts
+  double* im = new double[n]; //imaginary parts
+
+  for(size_t j=0; j<m_nSize; j++)
+    for(size_t i=0; i<m_nSize; i++){
+      const size_t k = j*m_nSize + i; //index
+      re[k] = (p[k] - mean)*m_dWindow[i]*m_dWindow[j];
+      im[k] = 0.0;
+    } //for
+
+  std::vector<std::thread> thread; //worker threads
+
+  for(size_t i=0; i<nThreads; i++)
+    thread.push_back(std::thread(&CSpectrum::FFTRows, this, re, im, i,
+      nThreads));
+
+  for(std::thread& th: thread)
+    th.join();
+
+  thread.clear();
+
+  for(size_t i=0; i<nThreads; i++)
+    thread.push_back(std::thread(&CSpectrum::FFTColumns, this, re, im, i,
+      nThreads));
+
+  for(std::thread& th: thread)
+    th.join();
+
+  for(size_t k=0; k<n; k++)
+    m_dPower[k] += re[k]*re[k] + im[k]*im[k];
+
+  delete [] re;
+  delete [] im;
+
+  m_nTiles++;
+} //Add
+
+/// Get the ring that a frequency falls in, that is, its distance from zero
+/// frequency rounded to the nearest whole number. Frequencies above the
+/// Nyquist frequency are the negative frequencies.
+/// \param i Column of frequency.
+/// \param j Row of frequency.
+/// \return Ring number.
+
+const size_t CSpectrum::GetRadius(size_t i, size_t j) const{
+  const double u = (double)((i <= m_nSize/2)? i: m_nSize - i); //X-frequency
+  const double v = (double)((j <= m_nSize/2)? j: m_nSize - j); //Y-frequency
+  return (size_t)(sqrt(u*u + v*v) + 0.5);
+} //GetRadius
+
+/// Get the radially averaged power spectrum for all rings in one pass.
+/// \param ring [OUT] Average power in each ring from 0 to `GetSize()/2`.
+
+void CSpectrum::GetRadialSpectrum(std::vector<double>& ring) const{
+  std::vector<size_t> count(m_nSize/2 + 1); //frequencies in each ring
+  ring.assign(m_nSize/2 + 1, 0.0);
+
+  for(size_t j=0; j<m_nSize; j++)
+    for(size_t i=0; i<m_nSize; i++){
+      const size_t r = GetRadius(i, j); //ring
+
+      if(r <= m_nSize/2){ //ignore the corners
+        ring[r] += m_dPower[j*m_nSize + i];
+        count[r]++;
+      } //if
+    } //for
+
+  for(size_t r=0; r<=m_nSize/2; r++)
+    if(count[r] > 0 && m_nTiles > 0)
+      ring[r] /= count[r]*m_nTiles;
+} //GetRadialSpectrum
+
+/// Get the tile width.
+/// \return Tile width.
+
+const size_t CSpectrum::GetSize() const{
+  return m_nSize;
+} //GetSize
+
+/// Get the number of octave bands, that is, \f$\log_2\f$ of half the tile
+/// width.
+/// \return Number of octave bands.
+
+const size_t CSpectrum::GetNumBands() const{
+  return m_nLog - 1;
+} //GetNumBands
+
+/// Get the fraction of the total power (excluding zero frequency) that is in
+/// an octave band. Band \f$k\f$ is the rings from \f$2^k\f$ up to but not
+/// including \f$2^{k+1}\f$, except that the last band also includes the
+/// Nyquist frequency.
+/// \param k Band number, less than `GetNumBands()`.
+/// \return Fraction of power in \f$[0, 1]\f$.
+
+const double CSpectrum::GetBand(size_t k) const{
+  std::vector<double> ring; //radially averaged power
+  GetRadialSpectrum(ring);
+
+  double band = 0.0; //power in band
+  double total = 0.0; //total power
+
+  for(size_t r=1; r<=m_nSize/2; r++){
+    total += ring[r];
+
+    if(r >= (1ULL << k) && (r < (2ULL << k) || k + 1 == GetNumBands()))
+      band += ring[r];
+  } //for
+
+  return (total > 0.0)? band/total: 0.0;
+} //GetBand
+
+/// Get the distance between the shapes of two radially averaged power
+/// spectra, that is, half the sum of the absolute differences between the
+/// fractions of power in each ring. This is 0 for identical shapes and 1
+/// for spectra with no rings in common.
+/// \param s Spectrum to compare with, which must have the same tile width.
+/// \return Distance in \f$[0, 1]\f$.
+
+const double CSpectrum::GetDistance(const CSpectrum& s) const{
+  if(s.m_nSize != m_nSize)return 1.0;
+
+  std::vector<double> a, b; //radially averaged power spectra
+  GetRadialSpectrum(a);
+  s.GetRadialSpectrum(b);
+
+  double sa = 0.0, sb = 0.0; //their sums
+
+  for(size_t r=1; r<=m_nSize/2; r++){
+    sa += a[r];
+    sb += b[r];
+  } //for
+
+  if(sa <= 0.0 || sb <= 0.0)return 1.0;
+
+  double d = 0.0; //sum of differences
+
+  for(size_t r=1; r<=m_nSize/2; r++)
+    d += fabs(a[r]/sa - b[r]/sb);
+
+  return d/2.0;
+} //GetDistance
+
+/// Get a measure of anisotropy. The frequencies in rings from 4 up to the
+/// ring that brings the total power to 99% are put into 8 sectors of
+/// directions between 0 and 180 degrees (the power spectrum of real values
+/// is symmetric about zero frequency). Opposite directions are in the same
+/// sector, and the sectors are offset by half a sector so that each axis is
+/// in the middle of one and both axes are measured in the same way. The
+/// power of each frequency is divided by the average power in its ring so
+/// that every ring counts equally, and these are averaged in each sector.
+/// The anisotropy is the difference between the largest and smallest sector
+/// averages divided by their mean. It is close to 0 if power does not depend
+/// on direction, and grows with the axis-aligned artifacts of lattice noise.
+/// \return Anisotropy.
+
+const double CSpectrum::GetAnisotropy() const{
+  const size_t nSectors = 8; //number of sectors
+  const double pi = 3.14159265358979323846; //pi
+
+  std::vector<double> ring; //radially averaged power
+  GetRadialSpectrum(ring);
+
+  std::vector<double> cumul(m_nSize/2 + 1); //power in rings up to each ring
+  std::vector<size_t> nRing(m_nSize/2 + 1); //frequencies in each ring
+
+  for(size_t j=0; j<m_nSize; j++)
+    for(size_t i=0; i<m_nSize; i++){
+      const size_t r = GetRadius(i, j); //ring
+      if(r <= m_nSize/2)nRing[r]++;
+    } //for
+
+  for(size_t r=1; r<=m_nSize/2; r++)
+    cumul[r] = cumul[r - 1] + ring[r]*nRing[r];
+
+  size_t rmax = 1; //largest ring used
+
+  while(rmax < m_nSize/2 && cumul[rmax] < 0.99*cumul[m_nSize/2])
+    rmax++;
+
+  double sum[nSectors] = {0}; //normalized power in each sector
+  size_t count[nSectors] = {0}; //frequencies in each sector
+
+  for(size_t j=0; j<m_nSize; j++)
+    for(size_t i=0; i<m_nSize; i++){
+      const size_t r = GetRadius(i, j); //ring
+      if(r < 4 || r > rmax || ring[r] <= 0.0)continue; //skip ring
+
+      const double u = (i <= m_nSize/2)? (double)i: (double)i - m_nSize;
+      const double v = (j <= m_nSize/2)? (double)j: (double)j - m_nSize;
+
+      double theta = atan2(v, u); //direction in (-pi, pi]
+      if(theta < 0.0)theta += pi; //in [0, pi]
+      theta += pi/(2*nSectors); //so that the axes are in mid-sector
+      if(theta >= pi)theta -= pi; //in [0, pi)
+
+      const size_t k = std::min(nSectors - 1, (size_t)(theta*nSectors/pi));
+      sum[k] += m_dPower[j*m_nSize + i]/(m_nTiles*ring[r]);
+      count[k]++;
+    } //for
+
+  double lo = 0.0, hi = 0.0, mean = 0.0; //smallest, largest, mean
+
+  for(size_t k=0; k<nSectors; k++){
+    const double a = (count[k] > 0)? sum[k]/count[k]: 0.0; //sector average
+    lo = (k == 0)? a: std::min(lo, a);
+    hi = (k == 0)? a: std::max(hi, a);
+    mean += a/nSectors;
+  } //for
+
+  return (mean > 0.0)? (hi - lo)/mean: 0.0;
+} //GetAnisotropy
@@ -0,0 +1,80 @@
+/// \file Spectrum.h
+///
+/// \brief Interface for the power spectrum analyzer.
+
+// MIT License
+//
+// Copyright (c) 2022 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#ifndef __SPECTRUM_H__
+#define __SPECTRUM_H__
+
+#include <cstddef>
+#include <vector>
+
+/// \brief Power spectrum analyzer.
+///
+/// Accumulates the two-dimensional power spectrum of square tiles of noise
+/// whose width is a power of 2, averaging over the tiles (Bartlett's method)
+/// so that a large noise field can be analyzed a tile at a time. Each tile
+/// has its mean removed and a Hann window applied before a self-contained
+/// radix-2 FFT, which transforms the rows and then the columns, each shared
+/// out among a number of threads. The result is summarized as a radially
+/// averaged power spectrum, the fraction of power in each octave band of
+/// frequencies, and an anisotropy measure that is 0 for noise whose power
+/// does not depend on direction. It owns its buffers, so it cannot be
+/// copied.
+
+class CSpectrum{
+  private:
+    size_t m_nSize = 0; ///< Tile width, a power of 2.
+    size_t m_nLog = 0; ///< Log base 2 of the tile width.
+    size_t m_nTiles = 0; ///< Number of tiles added.
+
+    double* m_dPower = nullptr; ///< Power at each frequency, row-major.
+    double* m_dCos = nullptr; ///< Twiddle factor cosines.
+    double* m_dSin = nullptr; ///< Twiddle factor sines.
+    double* m_dWindow = nullptr; ///< Hann window.
+    size_t* m_nReverse = nullptr; ///< Bit-reversal permutation.
+
+    void FFT(double*, double*, size_t) const; ///< In-place FFT.
+    void FFTRows(double*, double*, size_t, size_t) const; ///< FFT every n-th row.
+    void FFTColumns(double*, double*, size_t, size_t) const; ///< FFT every n-th column.
+    const size_t GetRadius(size_t, size_t) const; ///< Get ring of a frequency.
+    void GetRadialSpectrum(std::vector<double>&) const; ///< Get all rings.
+
+  public:
+    CSpectrum(size_t); ///< Constructor.
+    CSpectrum(const CSpectrum&) = delete; ///< No copy constructor.
+    CSpectrum& operator=(const CSpectrum&) = delete; ///< No copy assignment.
+    ~CSpectrum(); ///< Destructor.
+
+    void Clear(); ///< Clear.
+    void Add(const float*, size_t); ///< Add a tile of values.
+
+    const size_t GetSize() const; ///< Get tile width.
+    const size_t GetNumBands() const; ///< Get number of octave bands.
+    const double GetBand(size_t) const; ///< Get fraction of power in an octave band.
+    const double GetDistance(const CSpectrum&) const; ///< Distance between spectra.
+    const double GetAnisotropy() const; ///< Get anisotropy.
+}; //CSpectrum
+
+#endif //__SPECTRUM_H__
@@ -0,0 +1,279 @@
+/// \file Stats.cpp
+///
+/// \brief Code for the noise statistics accumulator.
+
+// MIT License
+//
+// Copyright (c) 2022 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include <emmintrin.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "Stats.h"
+
+/// Clear the accumulator.
+
+void CNoiseStats::Clear(){
+  *this = CNoiseStats();
+} //Clear
+
+/// Add a tile of values. The tile's minimum, maximum, and sums of the first
+/// four powers are computed four values at a time using SSE2, with the sums
+/// in double precision, and converted to central moments that are merged
+/// into the accumulator by `Merge()`. The histogram bin of each value is the
+/// gray level that `CMain::SetPixel()` draws it as.
+/// \param p Array of values in \f$[-1, 1]\f$.
+/// \param n Number of values.
+
+void CNoiseStats::Add(const float* p, size_t n){
+  if(n == 0)return;
+
+  CNoiseStats tile; //statistics for this tile
+  tile.m_nCount = n;
+
+  __m128 vmin = _mm_set1_ps(p[0]); //minima
+  __m128 vmax = vmin; //maxima
+  __m128d s1 = _mm_setzero_pd(), s2 = s1, s3 = s1, s4 = s1; //sums of powers
+
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 scale = _mm_set1_ps(255.0f);
+  alignas(16) int bin[4]; //histogram bins
+
+  size_t i = 0; //index into p
+
+  for(; i + 4 <= n; i += 4){ //four at a time
+    const __m128 x = _mm_loadu_ps(p + i);
+    vmin = _mm_min_ps(vmin, x);
+    vmax = _mm_max_ps(vmax, x);
+
+    for(int k=0; k<2; k++){ //low then high pair in double precision
+      const __m128d d = _mm_cvtps_pd(k? _mm_movehl_ps(x, x): x);
+      const __m128d d2 = _mm_mul_pd(d, d);
+      s1 = _mm_add_pd(s1, d);
+      s2 = _mm_add_pd(s2, d2);
+      s3 = _mm_add_pd(s3, _mm_mul_pd(d2, d));
+      s4 = _mm_add_pd(s4, _mm_mul_pd(d2, d2));
+    } //for
+
+    _mm_store_si128((__m128i*)bin, _mm_cvttps_epi32(_mm_mul_ps(scale,
+      _mm_add_ps(_mm_mul_ps(x, half), half)))); //gray levels
+
+    for(int k=0; k<4; k++)
+      tile.m_nHistogram[std::min(std::max(bin[k], 0), 255)]++;
+  } //for
+
+  //horizontal reductions
+
+  alignas(16) float fmin[4], fmax[4];
+  _mm_store_ps(fmin, vmin);
+  _mm_store_ps(fmax, vmax);
+  tile.m_fMin = std::min(std::min(fmin[0], fmin[1]), std::min(fmin[2], fmin[3]));
+  tile.m_fMax = std::max(std::max(fmax[0], fmax[1]), std::max(fmax[2], fmax[3]));
+
+  alignas(16) double d[2];
+  _mm_store_pd(d, s1); double S1 = d[0] + d[1];
+  _mm_store_pd(d, s2); double S2 = d[0] + d[1];
+  _mm_store_pd(d, s3); double S3 = d[0] + d[1];
+  _mm_store_pd(d, s4); double S4 = d[0] + d[1];
+
+  for(; i<n; i++){ //the rest one at a time
+    const float x = p[i];
+    tile.m_fMin = std::min(tile.m_fMin, x);
+    tile.m_fMax = std::max(tile.m_fMax, x);
+
+    const double dx = x;
+    S1 += dx; S2 += dx*dx; S3 += dx*dx*dx; S4 += dx*dx*dx*dx;
+
+    const int b = (int)(255.0f*(x*0.5f + 0.5f)); //gray level
+    tile.m_nHistogram[std::min(std::max(b, 0), 255)]++;
+  } //for
+
+  //central moments from sums of powers
+
+  const double m = S1/n; //mean
+  tile.m_dMean = m;
+  tile.m_dM2 = std::max(0.0, S2 - m*S1);
+  tile.m_dM3 = S3 - 3.0*m*S2 + 2.0*m*m*S1;
+  tile.m_dM4 = std::max(0.0, S4 - 4.0*m*S3 + 6.0*m*m*S2 - 3.0*m*m*m*S1);
+
+  Merge(tile);
+} //Add
+
+/// Merge another accumulator into this one, as if all of its values had been
+/// added to this one. The moments are combined using the pairwise update
+/// formulas, which are exact in exact arithmetic and numerically stable.
+/// \param s Accumulator to merge.
+
+void CNoiseStats::Merge(const CNoiseStats& s){
+  if(s.m_nCount == 0)return;
+
+  if(m_nCount == 0){
+    *this = s;
+    return;
+  } //if
+
+  const double na = (double)m_nCount; //count of this
+  const double nb = (double)s.m_nCount; //count of the other
+  const double n = na + nb; //total count
+  const double delta = s.m_dMean - m_dMean; //difference of means
+  const double delta2 = delta*delta;
+
+  const double M2 = m_dM2 + s.m_dM2 + delta2*na*nb/n;
+
+  const double M3 = m_dM3 + s.m_dM3 + delta2*delta*na*nb*(na - nb)/(n*n) +
+    3.0*delta*(na*s.m_dM2 - nb*m_dM2)/n;
+
+  const double M4 = m_dM4 + s.m_dM4 +
+    delta2*delta2*na*nb*(na*na - na*nb + nb*nb)/(n*n*n) +
+    6.0*delta2*(na*na*s.m_dM2 + nb*nb*m_dM2)/(n*n) +
+    4.0*delta*(na*s.m_dM3 - nb*m_dM3)/n;
+
+  m_dMean += delta*nb/n;
+  m_dM2 = M2; m_dM3 = M3; m_dM4 = M4;
+
+  m_nCount += s.m_nCount;
+  m_fMin = std::min(m_fMin, s.m_fMin);
+  m_fMax = std::max(m_fMax, s.m_fMax);
+
+  for(size_t i=0; i<256; i++)
+    m_nHistogram[i] += s.m_nHistogram[i];
+} //Merge
+
+/// Set this accumulator to the reduction of per-tile accumulators in a fixed
+/// binary tree order: merge neighboring tiles, then neighboring pairs, and so
+/// on. The order depends only on the number of tiles, which makes the result
+/// reproducible no matter which threads filled which tiles. A tree also keeps
+/// the accumulators being merged at similar sizes, which is good for
+/// precision.
+/// \param tile [IN, OUT] Accumulator for each tile, overwritten.
+
+void CNoiseStats::Reduce(std::vector<CNoiseStats>& tile){
+  for(size_t d=1; d<tile.size(); d*=2) //distance between merged tiles
+    for(size_t i=0; i+d<tile.size(); i+=2*d)
+      tile[i].Merge(tile[i + d]);
+
+  Clear();
+  if(!tile.empty())*this = tile[0];
+} //Reduce
+
+/// Test for exact equality, that is, the same count, minimum, maximum,
+/// histogram, and bit-for-bit the same mean and moments.
+/// \param s Accumulator to compare with.
+/// \return true if they are equal.
+
+const bool CNoiseStats::operator==(const CNoiseStats& s) const{
+  return m_nCount == s.m_nCount && m_fMin == s.m_fMin && m_fMax == s.m_fMax &&
+    memcmp(&m_dMean, &s.m_dMean, sizeof(double)) == 0 &&
+    memcmp(&m_dM2, &s.m_dM2, sizeof(double)) == 0 &&
+    memcmp(&m_dM3, &s.m_dM3, sizeof(double)) == 0 &&
+    memcmp(&m_dM4, &s.m_dM4, sizeof(double)) == 0 &&
+    memcmp(m_nHistogram, s.m_nHistogram, sizeof(m_nHistogram)) == 0;
+} //operator==
+
+/// Get an approximate percentile from the histogram, interpolating linearly
+/// within the bin that it falls in. The error is at most the width of one
+/// gray level, that is, \f$2/255\f$.
+/// \param p Fraction of values that are to be below the result, in
+/// \f$[0, 1]\f$. For example, 0.5 gives the median.
+/// \return Approximate percentile in \f$[-1, 1]\f$.
+
+const float CNoiseStats::GetPercentile(float p) const{
+  if(m_nCount == 0)return 0.0f;
+
+  const double target = p*(double)m_nCount; //number of values below result
+  double sum = 0.0; //number of values in bins so far
+
+  for(size_t i=0; i<256; i++){
+    const double count = (double)m_nHistogram[i]; //values in bin i
+
+    if(count > 0.0 && sum + count >= target){ //in this bin
+      const double t = (target - sum)/count; //fraction of the way through bin
+      const float x = (float)(2.0*(i + t)/255.0 - 1.0);
+      return std::min(std::max(x, m_fMin), m_fMax);
+    } //if
+
+    sum += count;
+  } //for
+
+  return m_fMax;
+} //GetPercentile
+
+/// Reader function for the number of values.
+/// \return The number of values.
+
+const size_t CNoiseStats::GetCount() const{
+  return m_nCount;
+} //GetCount
+
+/// Reader function for the smallest value.
+/// \return The smallest value, or zero if there are none.
+
+const float CNoiseStats::GetMin() const{
+  return m_fMin;
+} //GetMin
+
+/// Reader function for the largest value.
+/// \return The largest value, or zero if there are none.
+
+const float CNoiseStats::GetMax() const{
+  return m_fMax;
+} //GetMax
+
+/// Reader function for the mean.
+/// \return The mean, or zero if there are no values.
+
+const double CNoiseStats::GetMean() const{
+  return m_dMean;
+} //GetMean
+
+/// Get the (population) variance.
+/// \return The variance, or zero if there are no values.
+
+const double CNoiseStats::GetVariance() const{
+  return (m_nCount == 0)? 0.0: m_dM2/m_nCount;
+} //GetVariance
+
+/// Get the skewness, the third standardized moment.
+/// \return The skewness, or zero if the values are all the same.
+
+const double CNoiseStats::GetSkewness() const{
+  if(m_dM2 <= 0.0)return 0.0;
+  return sqrt((double)m_nCount)*m_dM3/pow(m_dM2, 1.5);
+} //GetSkewness
+
+/// Get the excess kurtosis, the fourth standardized moment minus 3 (which
+/// is the kurtosis of a normal distribution).
+/// \return The excess kurtosis, or zero if the values are all the same.
+
+const double CNoiseStats::GetKurtosis() const{
+  if(m_dM2 <= 0.0)return 0.0;
+  return m_nCount*m_dM4/(m_dM2*m_dM2) - 3.0;
+} //GetKurtosis
+
+/// Reader function for a histogram bin.
+/// \param i Gray level, less than 256.
+/// \return The number of values drawn at gray level `i`.
+
+const size_t CNoiseStats::GetHistogram(size_t i) const{
+  return (i < 256)? m_nHistogram[i]: 0;
+} //GetHistogram
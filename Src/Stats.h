@@ -0,0 +1,74 @@
+/// \file Stats.h
+///
+/// \brief Interface for the noise statistics accumulator.
+
+// MIT License
+//
+// Copyright (c) 2022 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#ifndef __STATS_H__
+#define __STATS_H__
+
+#include <cstddef>
+#include <vector>
+
+/// \brief Noise statistics accumulator.
+///
+/// Accumulates the count, minimum, maximum, mean, and central moments up to
+/// the fourth of a stream of noise values in \f$[-1, 1]\f$, together with a
+/// histogram with one bin for each of the 256 gray levels that the values
+/// are drawn as. Values are added a tile (for example, a row of pixels) at a
+/// time using SSE2, with the tile's sums kept in double precision, and
+/// accumulators are merged using the pairwise update formulas of Chan et al.
+/// and Pebay. This means that the statistics can be gathered by each thread
+/// as the noise is generated and merged at the end, with no separate pass
+/// over the noise and no loss of precision to a long float sum.
+
+class CNoiseStats{
+  private:
+    size_t m_nCount = 0; ///< Number of values.
+    float m_fMin = 0.0f; ///< Smallest value.
+    float m_fMax = 0.0f; ///< Largest value.
+    double m_dMean = 0.0; ///< Mean.
+    double m_dM2 = 0.0; ///< Sum of squared deviations from the mean.
+    double m_dM3 = 0.0; ///< Sum of cubed deviations from the mean.
+    double m_dM4 = 0.0; ///< Sum of fourth powers of deviations from the mean.
+    size_t m_nHistogram[256] = {0}; ///< Number of values at each gray level.
+
+  public:
+    void Clear(); ///< Clear.
+    void Add(const float*, size_t); ///< Add a tile of values.
+    void Merge(const CNoiseStats&); ///< Merge another accumulator.
+    void Reduce(std::vector<CNoiseStats>&); ///< Reduce tile accumulators.
+    const bool operator==(const CNoiseStats&) const; ///< Exact equality.
+
+    const size_t GetCount() const; ///< Get number of values.
+    const float GetMin() const; ///< Get smallest value.
+    const float GetMax() const; ///< Get largest value.
+    const double GetMean() const; ///< Get mean.
+    const double GetVariance() const; ///< Get variance.
+    const double GetSkewness() const; ///< Get skewness.
+    const double GetKurtosis() const; ///< Get excess kurtosis.
+    const float GetPercentile(float) const; ///< Get approximate percentile.
+    const size_t GetHistogram(size_t) const; ///< Get histogram bin.
+}; //CNoiseStats
+
+#endif //__STATS_H__
@@ -0,0 +1,136 @@
+/// \file TileCache.cpp
+///
+/// \brief Code for the in-memory tile cache.
+
+// MIT License
+//
+// Copyright (c) 2022 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include <cstring>
+
+#include "TileCache.h"
+
+/// Two keys are equal if all of their fields are equal.
+/// \param k A key.
+/// \return true if this key equals `k`.
+
+const bool TileKey::operator==(const TileKey& k) const{
+  return nX == k.nX && nY == k.nY && dPhaseX == k.dPhaseX &&
+    dPhaseY == k.dPhaseY && fScale == k.fScale && nVersion == k.nVersion;
+} //operator==
+
+/// The tiles are allocated as they are needed, up to the number that fit
+/// into the memory budget, but at least one.
+/// \param nTileSize Width and height of tiles in pixels.
+/// \param nBudget Maximum memory for noise values in bytes.
+
+CTileCache::CTileCache(size_t nTileSize, size_t nBudget):
+  m_nTileSize(nTileSize),
+  m_nMaxTiles(nBudget/(nTileSize*nTileSize*sizeof(float)))
+{
+  if(m_nMaxTiles == 0)m_nMaxTiles = 1;
+} //constructor
+
+/// Delete the noise values.
+
+CTileCache::~CTileCache(){
+  Clear();
+} //destructor
+
+/// Find the entry for a key.
+/// \param k Key.
+/// \return Pointer to the entry, nullptr if there isn't one.
+
+TileEntry* CTileCache::Find(const TileKey& k){
+  for(TileEntry& e: m_vEntry)
+    if(e.cKey == k)return &e;
+
+  return nullptr;
+} //Find
+
+/// Look up a tile and mark it as used.
+/// \param k Key.
+/// \return Pointer to the noise values of the tile, nullptr if it isn't in
+/// the cache. This is valid until the next call to `Put()` or `Clear()`.
+
+const float* CTileCache::Get(const TileKey& k){
+  TileEntry* p = Find(k);
+  if(p == nullptr)return nullptr; //miss
+
+  p->nLastUse = ++m_nClock;
+  return p->pData;
+} //Get
+
+/// Check whether a tile is in the cache without marking it as used.
+/// \param k Key.
+/// \return true if the tile is in the cache.
+
+const bool CTileCache::Has(const TileKey& k) const{
+  for(const TileEntry& e: m_vEntry)
+    if(e.cKey == k)return true;
+
+  return false;
+} //Has
+
+/// Store a copy of a tile. If the cache is full, then the least recently
+/// used tile is overwritten.
+/// \param k Key.
+/// \param pData Noise values of the tile, row-major.
+
+void CTileCache::Put(const TileKey& k, const float* pData){
+  TileEntry* p = Find(k);
+
+  if(p == nullptr){ //not already there
+    if(m_vEntry.size() < m_nMaxTiles){ //room for a new tile
+      m_vEntry.push_back(TileEntry());
+      p = &m_vEntry.back();
+      p->pData = new float[m_nTileSize*m_nTileSize];
+    } //if
+
+    else{ //reuse least recently used tile
+      p = &m_vEntry[0];
+
+      for(TileEntry& e: m_vEntry)
+        if(e.nLastUse < p->nLastUse)p = &e;
+    } //else
+
+    p->cKey = k;
+  } //if
+
+  memcpy(p->pData, pData, m_nTileSize*m_nTileSize*sizeof(float));
+  p->nLastUse = ++m_nClock;
+} //Put
+
+/// Remove all tiles and delete their noise values.
+
+void CTileCache::Clear(){
+  for(TileEntry& e: m_vEntry)
+    delete [] e.pData;
+
+  m_vEntry.clear();
+} //Clear
+
+/// Reader function for the tile size.
+/// \return Width and height of tiles in pixels.
+
+const size_t CTileCache::GetTileSize() const{
+  return m_nTileSize;
+} //GetTileSize
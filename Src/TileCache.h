@@ -0,0 +1,90 @@
+/// \file TileCache.h
+///
+/// \brief Interface for the in-memory tile cache.
+
+// MIT License
+//
+// Copyright (c) 2022 Ian Parberry
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#ifndef __TILECACHE_H__
+#define __TILECACHE_H__
+
+#include <cstdint>
+#include <vector>
+
+/// \brief Tile cache key.
+///
+/// A tile is a square of pixels in an infinite grid of pixels fixed in the
+/// noise plane, so that it stays put when the origin moves. The grid depends
+/// on the scale and on the fractional part of the origin in pixels, which is
+/// zero unless zooming out has moved the origin by a fraction of a pixel.
+/// The parameter version changes whenever any other noise parameter changes.
+
+struct TileKey{
+  int64_t nX = 0; ///< Tile column.
+  int64_t nY = 0; ///< Tile row.
+  double dPhaseX = 0.0; ///< Fractional part of the pixel grid X-coordinate.
+  double dPhaseY = 0.0; ///< Fractional part of the pixel grid Y-coordinate.
+  float fScale = 0.0f; ///< Scale.
+  uint64_t nVersion = 0; ///< Parameter version.
+
+  const bool operator==(const TileKey&) const; ///< Equality test.
+}; //TileKey
+
+/// \brief Tile cache entry.
+
+struct TileEntry{
+  TileKey cKey; ///< Key.
+  uint64_t nLastUse = 0; ///< Time of last use, in cache operations.
+  float* pData = nullptr; ///< Noise values, row-major.
+}; //TileEntry
+
+/// \brief In-memory tile cache.
+///
+/// A cache of square tiles of rendered noise values held in memory so that
+/// panning and zooming back to a part of the noise plane that has been seen
+/// before does not have to render it again. The number of tiles is limited
+/// by a memory budget, and the least recently used tile is reused when the
+/// cache is full. This class is not thread-safe, so it should only be used
+/// by one thread.
+
+class CTileCache{
+  private:
+    size_t m_nTileSize = 0; ///< Width and height of tiles in pixels.
+    size_t m_nMaxTiles = 0; ///< Maximum number of tiles.
+    uint64_t m_nClock = 0; ///< Number of cache operations so far.
+    std::vector<TileEntry> m_vEntry; ///< Tiles.
+
+    TileEntry* Find(const TileKey&); ///< Find a tile.
+
+  public:
+    CTileCache(size_t, size_t); ///< Constructor.
+    ~CTileCache(); ///< Destructor.
+
+    const float* Get(const TileKey&); ///< Look up a tile.
+    const bool Has(const TileKey&) const; ///< Check for a tile.
+    void Put(const TileKey&, const float*); ///< Store a tile.
+    void Clear(); ///< Remove all tiles.
+
+    const size_t GetTileSize() const; ///< Get tile size.
+}; //CTileCache
+
+#endif //__TILECACHE_H__
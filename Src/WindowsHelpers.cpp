@@ -82,26 +82,22 @@ HRESULT GetEncoderClsid(const WCHAR* format, CLSID* pClsid){
   return hr;
 } //GetEncoderClsid
 
-/// Display a `Save` dialog box for png files and save a bitmap to the file name
-/// that the user selects. Only files with a `.png` extension are allowed. The
-/// default file name is "ImageN.png", where N is the number of images saved
-/// so far in the current instance of this program. This prevents any collisions
-/// with files already saved by this instance. If there is a collision with a
-/// file from a previous instance, then the user is prompted to overwrite or
-/// rename it in the normal fashion. 
+/// Display a `Save` dialog box for png files and get the file name that the
+/// user selects. Only files with a `.png` extension are allowed. If there is
+/// a collision with an existing file, then the user is prompted to overwrite
+/// or rename it in the normal fashion. 
 /// \param hwnd Window handle.
-/// \param wstrName File name without extension.
-/// \param pBitmap Pointer to a bitmap.
+/// \param wstrName Default file name without extension.
+/// \param wstrFileName [OUT] Selected file name including path and extension.
 /// \return S_OK for success, E_FAIL for failure.
 
-HRESULT SaveBitmap(HWND hwnd, const std::wstring& wstrName, 
-  Gdiplus::Bitmap* pBitmap)
+HRESULT GetPNGFileName(HWND hwnd, const std::wstring& wstrName,
+  std::wstring& wstrFileName)
 {
   COMDLG_FILTERSPEC filetypes[] = { //png files only
     {L"PNG Files", L"*.png"}
   }; //filetypes
 
-  std::wstring wstrFileName; //result
   CComPtr<IFileSaveDialog> pDlg; //pointer to save dialog box
   CComPtr<IShellItem> pItem; //item pointer
   LPWSTR pwsz = nullptr; //pointer to null-terminated wide string for result
@@ -119,17 +115,96 @@ HRESULT SaveBitmap(HWND hwnd, const std::wstring& wstrName,
   if(FAILED(pDlg->GetResult(&pItem)))return E_FAIL; //get the result item
   if(FAILED(pItem->GetDisplayName(SIGDN_FILESYSPATH, &pwsz)))return E_FAIL; //get file name 
 
-  //wstrFileName should now contain the selected file name
+  wstrFileName = pwsz; //the selected file name
+  CoTaskMemFree(pwsz); //clean up
+
+  return S_OK;
+} //GetPNGFileName
+
+/// Display a `Save` or `Open` dialog box for golden image files and get the
+/// file name that the user selects. Only files with a `.golden` extension
+/// are allowed.
+/// \param hwnd Window handle.
+/// \param bSave true for a `Save` dialog box, false for `Open`.
+/// \param wstrFileName [OUT] Selected file name including path and extension.
+/// \return S_OK for success, E_FAIL for failure.
+
+HRESULT GetGoldenFileName(HWND hwnd, bool bSave, std::wstring& wstrFileName){
+  COMDLG_FILTERSPEC filetypes[] = { //golden files only
+    {L"Golden Files", L"*.golden"}
+  }; //filetypes
+
+  CComPtr<IFileDialog> pDlg; //pointer to save or open dialog box
+  CComPtr<IShellItem> pItem; //item pointer
+  LPWSTR pwsz = nullptr; //pointer to null-terminated wide string for result
+
+  //fire up the dialog box
+
+  if(FAILED(pDlg.CoCreateInstance(bSave? __uuidof(FileSaveDialog):
+    __uuidof(FileOpenDialog))))return E_FAIL;
+
+  pDlg->SetFileTypes(_countof(filetypes), filetypes); //set file types
+  pDlg->SetTitle(bSave? L"Save Golden Images": L"Check Golden Images");
+  pDlg->SetFileName(L"noise"); //set default file name
+  pDlg->SetDefaultExtension(L"golden"); //set default extension
 
+  if(FAILED(pDlg->Show(hwnd)))return E_FAIL; //show the dialog box     
+  if(FAILED(pDlg->GetResult(&pItem)))return E_FAIL; //get the result item
+  if(FAILED(pItem->GetDisplayName(SIGDN_FILESYSPATH, &pwsz)))return E_FAIL; //get file name 
+
+  wstrFileName = pwsz; //the selected file name
+  CoTaskMemFree(pwsz); //clean up
+
+  return S_OK;
+} //GetGoldenFileName
+
+/// Save a bitmap to a png file without asking the user anything. This can
+/// be called from any thread.
+/// \param wstrFileName File name including path and extension.
+/// \param pBitmap Pointer to a bitmap.
+/// \return S_OK for success, E_FAIL for failure.
+
+HRESULT SavePNG(const std::wstring& wstrFileName, Gdiplus::Bitmap* pBitmap){
   CLSID clsid; //for PNG class id
   if(FAILED(GetEncoderClsid((WCHAR*)L"image/png", &clsid)))return E_FAIL; //get
-  pBitmap->Save(pwsz, &clsid, nullptr); //the actual save happens here
 
-  CoTaskMemFree(pwsz); //clean up
+  if(pBitmap->Save(wstrFileName.c_str(), &clsid, nullptr) != Gdiplus::Ok)
+    return E_FAIL; //the actual save happens here
 
   return S_OK;
+} //SavePNG
+
+/// Display a `Save` dialog box for png files and save a bitmap to the file name
+/// that the user selects. The default file name is passed in by the caller.
+/// \param hwnd Window handle.
+/// \param wstrName File name without extension.
+/// \param pBitmap Pointer to a bitmap.
+/// \return S_OK for success, E_FAIL for failure.
+
+HRESULT SaveBitmap(HWND hwnd, const std::wstring& wstrName, 
+  Gdiplus::Bitmap* pBitmap)
+{
+  std::wstring wstrFileName; //file name selected by user
+  if(FAILED(GetPNGFileName(hwnd, wstrName, wstrFileName)))return E_FAIL;
+  return SavePNG(wstrFileName, pBitmap);
 } //SaveBitmap
 
+/// Get the folder for the render cache, which is a folder named
+/// `NoiseViewerCache` in the user's temporary folder. It is created if it
+/// does not already exist.
+/// \return Folder path ending in a backslash.
+
+const std::wstring GetCacheFolder(){
+  wchar_t buffer[MAX_PATH + 1]; //temporary folder path
+  std::wstring wstrFolder; //result
+
+  if(GetTempPathW(MAX_PATH + 1, buffer) > 0)wstrFolder = buffer;
+  wstrFolder += L"NoiseViewerCache\\";
+  CreateDirectoryW(wstrFolder.c_str(), nullptr); //fails harmlessly if it exists
+
+  return wstrFolder;
+} //GetCacheFolder
+
 #pragma endregion Save functions
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -146,6 +221,11 @@ HMENU CreateFileMenu(HMENU hMenubar){
   
   AppendMenuW(hMenu, MF_STRING, IDM_FILE_SAVE,  L"Save...");
   AppendMenuW(hMenu, MF_STRING, IDM_FILE_PROPS, L"Properties...");
+  AppendMenuW(hMenu, MF_STRING, IDM_FILE_BENCH, L"Benchmark...");
+  AppendMenuW(hMenu, MF_STRING, IDM_FILE_ANIM,  L"Export animation...");
+  AppendMenuW(hMenu, MF_STRING, IDM_FILE_GOLDEN, L"Save golden images...");
+  AppendMenuW(hMenu, MF_STRING, IDM_FILE_CHECK, L"Check golden images...");
+  AppendMenuW(hMenu, MF_STRING, IDM_FILE_FUZZ,  L"Fuzz kernels...");
   AppendMenuW(hMenu, MF_STRING, IDM_FILE_QUIT,  L"Quit");
   
   AppendMenuW(hMenubar, MF_POPUP, (UINT_PTR)hMenu, L"&File");
@@ -161,11 +241,14 @@ HMENU CreateGenerateMenu(HMENU hMenubar){
 
   AppendMenuW(hMenu, MF_STRING, IDM_GENERATE_PERLINNOISE, L"Perlin noise");
   AppendMenuW(hMenu, MF_STRING, IDM_GENERATE_VALUENOISE,  L"Value noise");
+  AppendMenuW(hMenu, MF_STRING, IDM_GENERATE_SIMPLEXNOISE, L"Simplex noise");
+  AppendMenuW(hMenu, MF_STRING, IDM_GENERATE_WORLEYNOISE,  L"Worley noise");
   AppendMenuW(hMenu, MF_SEPARATOR, 0, nullptr);
   AppendMenuW(hMenu, MF_STRING, IDM_GENERATE_JUMP, L"Jump");
   AppendMenuW(hMenu, MF_STRING, IDM_GENERATE_RESETORIGIN, L"Reset origin");
   AppendMenuW(hMenu, MF_SEPARATOR, 0, nullptr);
   AppendMenuW(hMenu, MF_STRING, IDM_GENERATE_RANDOMIZE,  L"Randomize");
+  AppendMenuW(hMenu, MF_STRING, IDM_GENERATE_SEARCH,  L"Search seeds...");
 
   AppendMenuW(hMenubar, MF_POPUP, (UINT_PTR)hMenu, L"&Generate");
   return hMenu;
@@ -213,6 +296,8 @@ HMENU CreateHashMenu(HMENU hMenubar){
   AppendMenuW(hMenu, MF_STRING, IDM_HASH_PERM,  L"Permutation");
   AppendMenuW(hMenu, MF_STRING, IDM_HASH_LCON,  L"Linear congruential");
   AppendMenuW(hMenu, MF_STRING, IDM_HASH_STD,   L"Std::hash");
+  AppendMenuW(hMenu, MF_STRING, IDM_HASH_FREE,  L"Table-free");
+  AppendMenuW(hMenu, MF_STRING, IDM_HASH_COPRIME, L"Coprime permutations");
 
   AppendMenuW(hMenubar, MF_POPUP, (UINT_PTR)hMenu, L"&Hash");
   return hMenu;
@@ -233,6 +318,37 @@ HMENU CreateSplineMenu(HMENU hMenubar){
   return hMenu;
 } //CreateSplineMenu
 
+/// Create the `Worley` menu.
+/// \param hMenubar Handle to menu bar.
+/// \return Handle to `Worley` menu.
+
+HMENU CreateWorleyMenu(HMENU hMenubar){
+  HMENU hMenu = CreateMenu();
+
+  AppendMenuW(hMenu, MF_STRING, IDM_WORLEY_F1,   L"Nearest (F1)");
+  AppendMenuW(hMenu, MF_STRING, IDM_WORLEY_F2,   L"Second nearest (F2)");
+  AppendMenuW(hMenu, MF_STRING, IDM_WORLEY_F2F1, L"Difference (F2 - F1)");
+
+  AppendMenuW(hMenubar, MF_POPUP, (UINT_PTR)hMenu, L"&Worley");
+  return hMenu;
+} //CreateWorleyMenu
+
+/// Create the `Fractal` menu.
+/// \param hMenubar Handle to menu bar.
+/// \return Handle to `Fractal` menu.
+
+HMENU CreateFractalMenu(HMENU hMenubar){
+  HMENU hMenu = CreateMenu();
+
+  AppendMenuW(hMenu, MF_STRING, IDM_FRACTAL_SUM,        L"Sum");
+  AppendMenuW(hMenu, MF_STRING, IDM_FRACTAL_TURBULENCE, L"Turbulence");
+  AppendMenuW(hMenu, MF_STRING, IDM_FRACTAL_BILLOW,     L"Billow");
+  AppendMenuW(hMenu, MF_STRING, IDM_FRACTAL_RIDGED,     L"Ridged multifractal");
+
+  AppendMenuW(hMenubar, MF_POPUP, (UINT_PTR)hMenu, L"F&ractal");
+  return hMenu;
+} //CreateFractalMenu
+
 /// Create the `Settings` menu.
 /// \param hMenubar Handle to menu bar.
 /// \return Handle to `Settings` menu.
@@ -252,6 +368,11 @@ HMENU CreateSettingsMenu(HMENU hMenubar){
   AppendMenuW(hMenu, MF_STRING, IDM_SETTINGS_TSIZE_DN, L"Table size down");
   AppendMenuW(hMenu, MF_SEPARATOR, 0, nullptr);
   AppendMenuW(hMenu, MF_STRING, IDM_SETTINGS_RESET, L"Reset to defaults");
+  AppendMenuW(hMenu, MF_SEPARATOR, 0, nullptr);
+  AppendMenuW(hMenu, MF_STRING, IDM_SETTINGS_FIXED, L"Fixed-point arithmetic");
+  AppendMenuW(hMenu, MF_STRING, IDM_SETTINGS_CULL, L"Cull octaves above Nyquist");
+  AppendMenuW(hMenu, MF_STRING, IDM_SETTINGS_WARP, L"Domain warp");
+  AppendMenuW(hMenu, MF_STRING, IDM_SETTINGS_ANIMATE, L"Animate");
   
   AppendMenuW(hMenubar, MF_POPUP, (UINT_PTR)hMenu, L"&Settings");
   return hMenu;
@@ -275,8 +396,9 @@ void CreateHelpMenu(HMENU hMenubar){
 
 #pragma region Update menu functions
 
-/// Gray out the `Properties` and `Save` menu entries in the `File` menu if
-/// there is no noise present, and ungray them otherwise.
+/// Gray out the `Properties`, `Save`, and `Export animation` menu entries
+/// in the `File` menu if there is no noise present, and ungray them
+/// otherwise.
 /// \param hMenu Menu handle.
 /// \param noise Noise enumerated type.
 
@@ -284,30 +406,41 @@ void UpdateFileMenu(HMENU hMenu, eNoise noise){
   if(noise == eNoise::None){
     EnableMenuItem(hMenu, IDM_FILE_SAVE,  MF_GRAYED);
     EnableMenuItem(hMenu, IDM_FILE_PROPS, MF_GRAYED);
+    EnableMenuItem(hMenu, IDM_FILE_ANIM,  MF_GRAYED);
   } //if
 
   else{
     EnableMenuItem(hMenu, IDM_FILE_SAVE,  MF_ENABLED);
     EnableMenuItem(hMenu, IDM_FILE_PROPS, MF_ENABLED);
+    EnableMenuItem(hMenu, IDM_FILE_ANIM,  MF_ENABLED);
   } //else
 } //UpdateFileMenu
 
 /// Gray out and set the checkmarks in the `Generate` menu according to the
 /// current noise properties. Check or uncheck the menu entries for pixel,
-/// Perlin, and Value noise depending on the current noise type. Gray out the
-/// `Randomize` menu entry if there is no noise generated, and ungray it
-/// otherwise.
+/// Perlin, Value, Simplex, and Worley noise depending on the current noise
+/// type. Gray out the `Randomize` and `Search seeds` menu entries if there is
+/// no noise generated, and ungray them otherwise. Also gray out the
+/// `Search seeds` menu entry if the seed search does not support the current
+/// settings.
 /// \param hMenu Menu handle.
 /// \param noise Noise enumerated type.
+/// \param bSearch true if the seed search supports the current settings.
 
-void UpdateGenerateMenu(HMENU hMenu, eNoise noise){
+void UpdateGenerateMenu(HMENU hMenu, eNoise noise, bool bSearch){
   CheckMenuItem(hMenu, IDM_GENERATE_PERLINNOISE, 
     (noise == eNoise::Perlin)? MF_CHECKED: MF_UNCHECKED);
   CheckMenuItem(hMenu, IDM_GENERATE_VALUENOISE,
     (noise == eNoise::Value)? MF_CHECKED: MF_UNCHECKED);
+  CheckMenuItem(hMenu, IDM_GENERATE_SIMPLEXNOISE,
+    (noise == eNoise::Simplex)? MF_CHECKED: MF_UNCHECKED);
+  CheckMenuItem(hMenu, IDM_GENERATE_WORLEYNOISE,
+    (noise == eNoise::Worley)? MF_CHECKED: MF_UNCHECKED);
   
   EnableMenuItem(hMenu, IDM_GENERATE_RANDOMIZE, 
     (noise == eNoise::None)? MF_GRAYED: MF_ENABLED);
+  EnableMenuItem(hMenu, IDM_GENERATE_SEARCH, 
+    (noise == eNoise::None || !bSearch)? MF_GRAYED: MF_ENABLED);
   EnableMenuItem(hMenu, IDM_GENERATE_JUMP, 
     (noise == eNoise::None)? MF_GRAYED: MF_ENABLED);
 
@@ -398,13 +531,19 @@ void UpdateHashMenu(HMENU hMenu, eNoise noise, eHash h){
       EnableMenuItem(hMenu, IDM_HASH_PERM,  MF_GRAYED);
       EnableMenuItem(hMenu, IDM_HASH_LCON,  MF_GRAYED);
       EnableMenuItem(hMenu, IDM_HASH_STD,   MF_GRAYED);
+      EnableMenuItem(hMenu, IDM_HASH_FREE,  MF_GRAYED);
+      EnableMenuItem(hMenu, IDM_HASH_COPRIME, MF_GRAYED);
     break;
 
     case eNoise::Perlin:
     case eNoise::Value:
+    case eNoise::Simplex:
+    case eNoise::Worley:
       EnableMenuItem(hMenu, IDM_HASH_PERM,  MF_ENABLED);
       EnableMenuItem(hMenu, IDM_HASH_LCON,  MF_ENABLED);
       EnableMenuItem(hMenu, IDM_HASH_STD,   MF_ENABLED);
+      EnableMenuItem(hMenu, IDM_HASH_FREE,  MF_ENABLED);
+      EnableMenuItem(hMenu, IDM_HASH_COPRIME, MF_ENABLED);
     break;
   } //switch
 
@@ -414,10 +553,14 @@ void UpdateHashMenu(HMENU hMenu, eNoise noise, eHash h){
     (h == eHash::LinearCongruential)? MF_CHECKED: MF_UNCHECKED);
   CheckMenuItem(hMenu, IDM_HASH_STD,
     (h == eHash::Std)? MF_CHECKED: MF_UNCHECKED);
+  CheckMenuItem(hMenu, IDM_HASH_FREE,
+    (h == eHash::Stateless)? MF_CHECKED: MF_UNCHECKED);
+  CheckMenuItem(hMenu, IDM_HASH_COPRIME,
+    (h == eHash::Coprime)? MF_CHECKED: MF_UNCHECKED);
 } //UpdateHashMenu
 
 /// Gray out and set the checkmarks in the `Spline` menu according to the
-/// current noise and spline types.
+/// current noise and spline types. Simplex and Worley noise don't use a spline.
 /// \param hMenu Menu handle.
 /// \param noise Noise enumerated type.
 /// \param spline Spline enumerated type.
@@ -425,6 +568,8 @@ void UpdateHashMenu(HMENU hMenu, eNoise noise, eHash h){
 void UpdateSplineMenu(HMENU hMenu, eNoise noise, eSpline spline){
   switch(noise){
     case eNoise::None: 
+    case eNoise::Simplex:
+    case eNoise::Worley:
       EnableMenuItem(hMenu, IDM_SPLINE_NONE,     MF_GRAYED);
       EnableMenuItem(hMenu, IDM_SPLINE_CUBIC,    MF_GRAYED);
       EnableMenuItem(hMenu, IDM_SPLINE_QUINTIC,  MF_GRAYED);
@@ -446,6 +591,52 @@ void UpdateSplineMenu(HMENU hMenu, eNoise noise, eSpline spline){
     (spline == eSpline::Quintic)? MF_CHECKED: MF_UNCHECKED);
 } //UpdateSplineMenu
 
+/// Gray out and set the checkmarks in the `Worley` menu according to the
+/// current noise type and Worley noise distance. The menu is grayed out
+/// unless the noise is Worley noise.
+/// \param hMenu Menu handle.
+/// \param noise Noise enumerated type.
+/// \param d Worley noise distance enumerated type.
+
+void UpdateWorleyMenu(HMENU hMenu, eNoise noise, eWorley d){
+  const UINT flag = (noise == eNoise::Worley)? MF_ENABLED: MF_GRAYED;
+
+  EnableMenuItem(hMenu, IDM_WORLEY_F1,   flag);
+  EnableMenuItem(hMenu, IDM_WORLEY_F2,   flag);
+  EnableMenuItem(hMenu, IDM_WORLEY_F2F1, flag);
+
+  CheckMenuItem(hMenu, IDM_WORLEY_F1,
+    (d == eWorley::F1)? MF_CHECKED: MF_UNCHECKED);
+  CheckMenuItem(hMenu, IDM_WORLEY_F2,
+    (d == eWorley::F2)? MF_CHECKED: MF_UNCHECKED);
+  CheckMenuItem(hMenu, IDM_WORLEY_F2F1,
+    (d == eWorley::F2MinusF1)? MF_CHECKED: MF_UNCHECKED);
+} //UpdateWorleyMenu
+
+/// Gray out and set the checkmarks in the `Fractal` menu according to the
+/// current noise and fractal types.
+/// \param hMenu Menu handle.
+/// \param noise Noise enumerated type.
+/// \param d Fractal enumerated type.
+
+void UpdateFractalMenu(HMENU hMenu, eNoise noise, eFractal d){
+  const UINT flag = (noise == eNoise::None)? MF_GRAYED: MF_ENABLED;
+
+  EnableMenuItem(hMenu, IDM_FRACTAL_SUM,        flag);
+  EnableMenuItem(hMenu, IDM_FRACTAL_TURBULENCE, flag);
+  EnableMenuItem(hMenu, IDM_FRACTAL_BILLOW,     flag);
+  EnableMenuItem(hMenu, IDM_FRACTAL_RIDGED,     flag);
+
+  CheckMenuItem(hMenu, IDM_FRACTAL_SUM,
+    (d == eFractal::Sum)? MF_CHECKED: MF_UNCHECKED);
+  CheckMenuItem(hMenu, IDM_FRACTAL_TURBULENCE,
+    (d == eFractal::Turbulence)? MF_CHECKED: MF_UNCHECKED);
+  CheckMenuItem(hMenu, IDM_FRACTAL_BILLOW,
+    (d == eFractal::Billow)? MF_CHECKED: MF_UNCHECKED);
+  CheckMenuItem(hMenu, IDM_FRACTAL_RIDGED,
+    (d == eFractal::Ridged)? MF_CHECKED: MF_UNCHECKED);
+} //UpdateFractalMenu
+
 /// Gray out entries in the `Settings` menu if they are not appropriate for the
 /// current noise type and parameters.
 /// \param hMenu Menu handle.
@@ -459,5 +650,18 @@ void UpdateSettingsMenu(HMENU hMenu, eNoise noise){
     EnableMenuItem(hMenu, IDM_SETTINGS_SCALE_DN,  MF_GRAYED);
     EnableMenuItem(hMenu, IDM_SETTINGS_TSIZE_UP,  MF_GRAYED);
     EnableMenuItem(hMenu, IDM_SETTINGS_TSIZE_DN,  MF_GRAYED);
+    EnableMenuItem(hMenu, IDM_SETTINGS_FIXED,     MF_GRAYED);
+    EnableMenuItem(hMenu, IDM_SETTINGS_CULL,      MF_GRAYED);
+    EnableMenuItem(hMenu, IDM_SETTINGS_WARP,      MF_GRAYED);
+    EnableMenuItem(hMenu, IDM_SETTINGS_ANIMATE,   MF_GRAYED);
   } //if
+
+  else{
+    EnableMenuItem(hMenu, IDM_SETTINGS_FIXED,
+      (noise == eNoise::Simplex || noise == eNoise::Worley)?
+        MF_GRAYED: MF_ENABLED);
+    EnableMenuItem(hMenu, IDM_SETTINGS_CULL,  MF_ENABLED);
+    EnableMenuItem(hMenu, IDM_SETTINGS_WARP,  MF_ENABLED);
+    EnableMenuItem(hMenu, IDM_SETTINGS_ANIMATE, MF_ENABLED);
+  } //else
 } //UpdateSettingsMenu
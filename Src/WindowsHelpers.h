@@ -40,12 +40,20 @@
 #define IDM_FILE_SAVE  1 ///< Menu id for Save.
 #define IDM_FILE_PROPS 2 ///< Menu id for Properties.
 #define IDM_FILE_QUIT  3 ///< Menu id for Quit.
+#define IDM_FILE_BENCH 35 ///< Menu id for Benchmark.
+#define IDM_FILE_ANIM  48 ///< Menu id for Export Animation.
+#define IDM_FILE_GOLDEN 49 ///< Menu id for Save Golden Images.
+#define IDM_FILE_CHECK 50 ///< Menu id for Check Golden Images.
+#define IDM_FILE_FUZZ  51 ///< Menu id for Fuzz Kernels.
 
 #define IDM_GENERATE_PERLINNOISE 4 ///< Menu id for Perlin Noise.
 #define IDM_GENERATE_VALUENOISE  5 ///< Menu id for Value Noise.
+#define IDM_GENERATE_SIMPLEXNOISE 37 ///< Menu id for Simplex Noise.
+#define IDM_GENERATE_WORLEYNOISE 38 ///< Menu id for Worley Noise.
 #define IDM_GENERATE_RANDOMIZE   6 ///< Menu id for regenerate Noise.
 #define IDM_GENERATE_JUMP        7 ///< Menu id for jump.
 #define IDM_GENERATE_RESETORIGIN 8 ///< Menu id for reset origin.
+#define IDM_GENERATE_SEARCH     52 ///< Menu id for search seeds.
 
 #define IDM_VIEW_COORDS  9 ///< Menu id for view coordinates.
 #define IDM_VIEW_GRID   10 ///< Menu id for view grid.
@@ -60,11 +68,22 @@
 #define IDM_HASH_PERM   17 ///< Menu id for permutation hash.
 #define IDM_HASH_LCON   18 ///< Menu id for linear congruential hash.
 #define IDM_HASH_STD    19 ///< Menu id for std::hash.
+#define IDM_HASH_FREE   34 ///< Menu id for table-free hash.
+#define IDM_HASH_COPRIME 36 ///< Menu id for coprime permutation hash.
 
 #define IDM_SPLINE_NONE    20 ///< Menu id for cubic spline.
 #define IDM_SPLINE_CUBIC   21 ///< Menu id for no spline.
 #define IDM_SPLINE_QUINTIC 22 ///< Menu id for quintic spline.
 
+#define IDM_WORLEY_F1   39 ///< Menu id for Worley distance F1.
+#define IDM_WORLEY_F2   40 ///< Menu id for Worley distance F2.
+#define IDM_WORLEY_F2F1 41 ///< Menu id for Worley distance F2 - F1.
+
+#define IDM_FRACTAL_SUM        42 ///< Menu id for sum of octaves.
+#define IDM_FRACTAL_TURBULENCE 43 ///< Menu id for turbulence.
+#define IDM_FRACTAL_BILLOW     44 ///< Menu id for billow.
+#define IDM_FRACTAL_RIDGED     45 ///< Menu id for ridged multifractal.
+
 #define IDM_SETTINGS_OCTAVE_UP 23 ///< Menu id for octave up.
 #define IDM_SETTINGS_OCTAVE_DN 24 ///< Menu id for octave down.
 #define IDM_SETTINGS_SCALE_UP  25 ///< Menu id for scale up.
@@ -72,6 +91,10 @@
 #define IDM_SETTINGS_TSIZE_UP  27 ///< Menu id for table size up.
 #define IDM_SETTINGS_TSIZE_DN  28 ///< Menu id for table size down.
 #define IDM_SETTINGS_RESET     29 ///< Menu id for reset settings.
+#define IDM_SETTINGS_FIXED     32 ///< Menu id for fixed-point arithmetic.
+#define IDM_SETTINGS_CULL      33 ///< Menu id for octave culling.
+#define IDM_SETTINGS_WARP      46 ///< Menu id for domain warping.
+#define IDM_SETTINGS_ANIMATE   47 ///< Menu id for animation.
 
 #define IDM_HELP_HELP  30 ///< Menu id for display help.
 #define IDM_HELP_ABOUT 31 ///< Menu id for display About info.
@@ -89,7 +112,11 @@ ULONG_PTR InitGDIPlus(); ///< Initialize GDI+.
 
 //others
 
+HRESULT GetPNGFileName(HWND, const std::wstring&, std::wstring&); ///< Get png file name from user.
+HRESULT GetGoldenFileName(HWND, bool, std::wstring&); ///< Get golden file name from user.
+HRESULT SavePNG(const std::wstring&, Gdiplus::Bitmap*); ///< Save bitmap to png file.
 HRESULT SaveBitmap(HWND, const std::wstring&, Gdiplus::Bitmap*); ///< Save bitmap to file.
+const std::wstring GetCacheFolder(); ///< Get render cache folder.
 
 #pragma endregion Helper functions
 
@@ -104,6 +131,8 @@ HMENU CreateViewMenu(HMENU); ///< Create `View` menu.
 HMENU CreateDistributionMenu(HMENU); ///< Create `Distribution` menu.
 HMENU CreateHashMenu(HMENU); ///< Create `Hash` menu.
 HMENU CreateSplineMenu(HMENU); ///< Create `Spline` menu.
+HMENU CreateWorleyMenu(HMENU); ///< Create `Worley` menu.
+HMENU CreateFractalMenu(HMENU); ///< Create `Fractal` menu.
 HMENU CreateSettingsMenu(HMENU); ///< Create `Settings` menu.
 void CreateHelpMenu(HMENU); ///< Create `Help` menu.
 
@@ -111,12 +140,14 @@ void UpdateMenuItemGray(HMENU, UINT, eNoise, bool); ///< Update menu item bool.
 void UpdateMenuItemCheck(HMENU, UINT, bool); ///< Update menu item check.
 
 void UpdateFileMenu(HMENU, eNoise); ///< Update `File` menu.
-void UpdateGenerateMenu(HMENU, eNoise); ///< Update `Generate` menu.
+void UpdateGenerateMenu(HMENU, eNoise, bool); ///< Update `Generate` menu.
 void UpdateViewMenu(HMENU, eNoise); ///< Update `View` menu.
 
 void UpdateDistributionMenu(HMENU, eNoise, eDistribution); ///< Update `Distribution` menu.
 void UpdateHashMenu(HMENU, eNoise, eHash); ///< Update `Hash` menu.
 void UpdateSplineMenu(HMENU, eNoise, eSpline); ///< Update `Spline` menu.
+void UpdateWorleyMenu(HMENU, eNoise, eWorley); ///< Update `Worley` menu.
+void UpdateFractalMenu(HMENU, eNoise, eFractal); ///< Update `Fractal` menu.
 void UpdateSettingsMenu(HMENU, eNoise); ///< Update `Settings` menu.
 
 /// \brief Update a numeric menu item.
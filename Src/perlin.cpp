@@ -25,22 +25,40 @@
 // IN THE SOFTWARE.
 
 #include <stdlib.h>
+#include <cstring>
 #include <algorithm>
 #include <functional>
+#include <thread>
+#include <vector>
 
-#include "Perlin.h"
+#include "perlin.h"
 #include "Helpers.h"
-#include "Includes.h"
+
+#ifdef _WIN32
+  #include "Includes.h"
+#else
+  #include <cassert>
+  #include <chrono>
+  #include <cmath>
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 // Constructor and destructor.
 
 #pragma region Constructor and destructor
 
-/// Set the PRNG seed and initialize.
+/// Batch kernel for each instruction set, indexed by `eISA`. The scalar
+/// entry is `nullptr`, meaning that `generate()` is called for each point.
+
+const NoiseKernel CPerlinNoise2D::m_pKernelTable[] = {
+  nullptr, NoiseKernelSSE2, NoiseKernelAVX2, NoiseKernelAVX512
+}; //m_pKernelTable
+
+/// Set the PRNG seed, choose the batch kernel, and initialize.
 
 CPerlinNoise2D::CPerlinNoise2D(){  
   SetSeed();
+  SetISA(BestISA());
   Initialize(); 
 } //constructor
 
@@ -48,6 +66,8 @@ CPerlinNoise2D::CPerlinNoise2D(){
 
 CPerlinNoise2D::~CPerlinNoise2D(){
   delete [] m_fTable;
+  delete [] m_fTable0;
+  delete [] m_nTable16;
   delete [] m_nPerm;
 } //destructor
 
@@ -60,8 +80,29 @@ void CPerlinNoise2D::Initialize(){
   assert(m_nSize > 1); //safety
 
   m_nMask = m_nSize - 1;  //mask of n consecutive 1s
-  m_nPerm = new size_t[m_nSize]; //permutation
-  m_fTable = new float[m_nSize]; //gradients or height values
+  m_nTableSize = std::min<size_t>(m_nSize, m_nBlockSize); //gradient/value table size
+  m_nTableMask = m_nTableSize - 1; //mask of n consecutive 1s
+
+  if(m_nSize <= m_nBlockSize){ //one-level permutation
+    m_nHiMask = 0;
+    m_nPerm = new uint32_t[m_nSize]; //permutation
+    m_nPermLo = m_nPermHi = m_nKeyLo = m_nKeyHi = nullptr;
+  } //if
+
+  else{ //two-level permutation
+    const size_t nHi = m_nSize >> m_nBlockBits; //number of high bit values
+    m_nHiMask = nHi - 1; //mask of n consecutive 1s
+
+    m_nPerm = new uint32_t[2*(m_nBlockSize + nHi)]; //all four small tables
+    m_nPermLo = m_nPerm;
+    m_nKeyLo  = m_nPermLo + m_nBlockSize;
+    m_nPermHi = m_nKeyLo  + m_nBlockSize;
+    m_nKeyHi  = m_nPermHi + nHi;
+  } //else
+
+  m_fTable = new float[m_nTableSize]; //gradients or height values
+  m_fTable0 = new float[m_nTableSize]; //gradients or height values at time zero
+  m_nTable16 = new int16_t[m_nTableSize]; //fixed-point gradients or height values
 
   RandomizeTable(m_eDistribution); //randomize gradient/value table
   RandomizePermutation(); //randomize permutation
@@ -74,31 +115,97 @@ void CPerlinNoise2D::Initialize(){
 
 #pragma region Functions that change noise settings
 
-/// Use the standard algorithm to set the permutation in `m_nPerm` to a
-/// pseudo-random permutation with each permutation equally likely .
-/// The source of randomness is `std::default_random_engine`
-/// with `std::uniform_int_distribution`. This function should be called
-/// during initialization and when the table size changes. The pseudo-random
-/// number generator is re-seeded from `m_nSeed` before the permutation is
-/// generated. This means that the permutation used for each table size remains
-/// the same until `m_nSeed` is changed.
+/// Counter-based pseudo-random number generator. Rather than drawing numbers
+/// one after the other from a generator with hidden state, the \f$i\f$th
+/// number of a stream is computed directly from the seed, the stream, and
+/// \f$i\f$ using SplitMix64. The seed and stream are mixed into a key,
+/// then the key plus \f$i + 1\f$ times the golden ratio increment is mixed
+/// again. Since this uses nothing but 64-bit integer arithmetic, it gives the
+/// same results on every platform and compiler, and table entries can be
+/// generated in any order.
+/// \param stream Stream number, one for each table.
+/// \param i Index into the stream.
+/// \return A pseudo-random 64-bit number.
+
+inline const uint64_t CPerlinNoise2D::random(size_t stream, size_t i) const{
+  const uint64_t gamma = 0x9E3779B97F4A7C15ULL; //golden ratio increment
+
+  auto mix = [](uint64_t z){ //SplitMix64 finalizer
+    z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }; //mix
+
+  const uint64_t key = mix(((uint64_t)m_nSeed << 32 | (uint64_t)stream)*gamma);
+  return mix(key + ((uint64_t)i + 1)*gamma);
+} //random
+
+/// Pseudo-random float drawn uniformly from \f$[0, 1)\f$ with 24 bits of
+/// precision, that is, every multiple of \f$2^{-24}\f$ in that range is
+/// equally likely.
+/// \param stream Stream number, one for each table.
+/// \param i Index into the stream.
+/// \return A pseudo-random float in \f$[0, 1)\f$.
+
+inline const float CPerlinNoise2D::uniform(size_t stream, size_t i) const{
+  return (random(stream, i) >> 40)/16777216.0f;
+} //uniform
+
+/// Use the standard algorithm to set an array to a pseudo-random permutation
+/// with each permutation equally likely. The source of randomness is
+/// the counter-based generator `random()`, the \f$i\f$th swap using the
+/// \f$i\f$th number of the stream.
+/// \param p [OUT] Array to be filled with a permutation.
+/// \param n Number of entries in the array.
+/// \param stream PRNG stream.
+
+void CPerlinNoise2D::Shuffle(uint32_t* p, size_t n, size_t stream){
+  for(size_t i=0; i<n; i++) //identity permutation
+    p[i] = (uint32_t)i; 
+
+  for(size_t i=0; i<n; i++){ //randomize
+    const uint64_t r = random(stream, i) >> 32; //32 random bits
+    const size_t j = i + (size_t)((r*(n - i)) >> 32); //in [i, n)
+    std::swap(p[i], p[j]);
+  } //for
+} //Shuffle
+
+/// Set the permutation used by `hash()` to a pseudo-random permutation, and
+/// likewise the three small permutations used by `hashcoprime()`.
+/// If `m_nSize` is at most `m_nBlockSize`, then `m_nPerm` is simply shuffled.
+/// Otherwise the permutation is two-level, and its four small tables are
+/// randomized instead: permutations of the low and high bits, and keys
+/// that are XORed into each half depending on the other half.
+/// This function should be called during initialization and when the table
+/// size changes. The permutation used for each table size remains the same
+/// until `m_nSeed` is changed.
 
 void CPerlinNoise2D::RandomizePermutation(){
-  for(size_t i=0; i<m_nSize; i++) //identity permutation
-    m_nPerm[i] = i; 
+  Shuffle(m_nPerm251, 251, m_nCoprimeStream); //for the coprime hash
+  Shuffle(m_nPerm256, 256, m_nCoprimeStream + 1); //for the coprime hash
+  Shuffle(m_nPerm257, 257, m_nCoprimeStream + 2); //for the coprime hash
 
-  m_stdRandom.seed(m_nSeed); //reset PRNG
+  if(m_nSize <= m_nBlockSize){ //one-level permutation
+    Shuffle(m_nPerm, m_nSize, m_nPermStream);
+    return;
+  } //if
 
-  for(size_t i=0; i<m_nSize; i++){ //randomize
-    std::uniform_int_distribution<size_t> d(i, m_nSize - 1);
-    std::swap(m_nPerm[i], m_nPerm[d(m_stdRandom)]);
-  } //for
+  const size_t nHi = m_nHiMask + 1; //number of high bit values
+
+  Shuffle(m_nPermLo, m_nBlockSize, m_nPermStream);
+  Shuffle(m_nPermHi, nHi, m_nPermHiStream);
+
+  for(size_t i=0; i<m_nBlockSize; i++) //keys for the high bits
+    m_nKeyLo[i] = (uint32_t)(random(m_nKeyStream, i) & m_nHiMask);
+
+  for(size_t i=0; i<nHi; i++) //keys for the low bits
+    m_nKeyHi[i] = (uint32_t)(random(m_nKeyStream, m_nBlockSize + i) >> (64 - m_nBlockBits));
 } //RandomizePermutation
 
 /// Initialize a chunk of the gradient/value table `m_fTable` using midpoint
 /// displacement. Given \f$\mathsf{i}\f$ and \f$\mathsf{j}\f$ such that
 /// \f$\mathsf{j} > \mathsf{i}+1\f$ and
-/// \f$0 \leq \mathsf{i}, \mathsf{j} \leq\f$ `m_nSize`, where
+/// \f$0 \leq \mathsf{i}, \mathsf{j} \leq\f$ `m_nTableSize`, where
 /// \f$\mathsf{j} - \mathsf{i}\f$ is a power of 2, this function assumes that
 /// `m_fTable`\f$[\mathsf{i}]\f$ and  `m_fTable`\f$[\mathsf{j}]\f$ have
 /// been set, and fills in the entries `m_fTable`\f$[\mathsf{i} + 1]\f$
@@ -107,17 +214,16 @@ void CPerlinNoise2D::RandomizePermutation(){
 /// first and last entry offset by a pseudo-random value in \f$[-1,1]\f$
 /// times a value called the _lacunarity_. The function then halves the
 /// lacunarity and calls itself recursively on the top and bottom halves of
-/// the table chunk. The source of randomness is `std::default_random_engine`
-/// with `std::uniform_real_distribution<float>(-1.0f, 1.0f)`.
+/// the table chunk. The source of randomness is `uniform()`, the offset
+/// of the midpoint at index \f$k\f$ using the \f$k\f$th number, scaled
+/// to \f$[-1,1)\f$.
 /// \param i Lower index.
 /// \param j Upper index.
 /// \param alpha Lacunarity.
 
 void CPerlinNoise2D::RandomizeTableMidpoint(size_t i, size_t j, float alpha){
-  assert(i < j && j < m_nSize);
-  assert(alpha < 0.0f);
-
-  std::uniform_real_distribution<float> d(-1.0f, 1.0f);
+  assert(i < j && j < m_nTableSize);
+  assert(alpha > 0.0f);
 
   if(j > i + 1){ //there is a midpoint to fill in
     const size_t mid = (i + j)/2; //mid point
@@ -125,7 +231,7 @@ void CPerlinNoise2D::RandomizeTableMidpoint(size_t i, size_t j, float alpha){
     assert(i < mid && mid < j);
 
     const float fMean = (m_fTable[i] + m_fTable[j])/2.0f; //average of ends
-    const float fRand = alpha*d(m_stdRandom); //random offset
+    const float fRand = alpha*(2.0f*uniform(m_nTableStream, mid) - 1.0f); //random offset
     m_fTable[mid] = clamp(-1.0f, fMean + fRand, 1.0f); //mid point is average plus offset
     alpha *= 0.5f; //increase lacunarity
 
@@ -140,92 +246,86 @@ void CPerlinNoise2D::RandomizeTableMidpoint(size_t i, size_t j, float alpha){
 
 void CPerlinNoise2D::RandomizeTableMidpoint(){
   m_fTable[0] = 1.0f;
-  m_fTable[m_nSize - 1] = -1.0f;
+  m_fTable[m_nTableSize - 1] = -1.0f;
 
-  RandomizeTableMidpoint(0, m_nSize - 1, 0.5f);
+  RandomizeTableMidpoint(0, m_nTableSize - 1, 0.5f);
 } //RandomizeTableMidpoint
 
 /// Fill the gradient/value table `m_fTable` using a uniform distribution.
-/// The source of randomness is `std::default_random_engine`
-/// with `std::uniform_real_distribution<float>(-1.0f, 1.0f)`.
+/// The source of randomness is `uniform()`, scaled to \f$[-1,1)\f$.
 
 void CPerlinNoise2D::RandomizeTableUniform(){  
-  std::uniform_real_distribution<float> d(-1.0f, 1.0f);
-
-  for(size_t i=0; i<m_nSize; i++){
-    m_fTable[i] = d(m_stdRandom);
+  for(size_t i=0; i<m_nTableSize; i++){
+    m_fTable[i] = 2.0f*uniform(m_nTableStream, i) - 1.0f;
     assert(-1.0f <= m_fTable[i] && m_fTable[i] <= 1.0f);
   } //for
 } //RandomizeTableUniform
 
 /// Fill the gradient/value table `m_fTable` with large magnitude entries,
 /// that is, either -1 ot +1, using a uniform distribution. The source of
-/// randomness is `std::default_random_engine` with
-/// `std::uniform_real_distribution<float>(-1.0f, 1.0f)`.
+/// randomness is `uniform()`.
 
 void CPerlinNoise2D::RandomizeTableMaximal(){  
-  std::uniform_real_distribution<float> d(-1.0f, 1.0f);
-
-  for(size_t i=0; i<m_nSize; i++){
-    m_fTable[i] = (d(m_stdRandom) > 0.0f)? 1.0f: -1.0f;
+  for(size_t i=0; i<m_nTableSize; i++){
+    m_fTable[i] = (uniform(m_nTableStream, i) >= 0.5f)? 1.0f: -1.0f;
     assert(-1.0f <= m_fTable[i] && m_fTable[i] <= 1.0f);
   } //for
 } //RandomizeTableMaximal
 
-/// Fill the gradient/value table `m_fTable` using a normal distribution.
-/// The source of randomness is `std::default_random_engine`
-/// with `std::normal_distribution<float>(500.0f, 200.0f)`.
+/// Fill the gradient/value table `m_fTable` using a normal distribution
+/// with mean 500 and standard deviation 200, scaled down by 1000 and clamped
+/// to \f$[0, 1]\f$, then mapped to \f$[-1, 1]\f$. The source of
+/// randomness is `uniform()`, with two numbers per table entry turned into
+/// a normally distributed one by the Box-Muller transform.
 
 void CPerlinNoise2D::RandomizeTableNormal(){  
-  std::normal_distribution<float> d(500.0f, 200.0f);
-
-  for(size_t i=0; i<m_nSize; i++){
-    m_fTable[i] = 2.0f*clamp(0.0f, d(m_stdRandom)/1000.0f, 1.0f) - 1.0f;
+  for(size_t i=0; i<m_nTableSize; i++){
+    const float u0 = uniform(m_nTableStream, 2*i); //first uniform
+    const float u1 = uniform(m_nTableStream, 2*i + 1); //second uniform
+    const float n = sqrtf(-2.0f*logf(1.0f - u0))*cosf(2.0f*PI*u1); //Box-Muller
+    m_fTable[i] = 2.0f*clamp(0.0f, (500.0f + 200.0f*n)/1000.0f, 1.0f) - 1.0f;
     assert(-1.0f <= m_fTable[i] && m_fTable[i] <= 1.0f);
   } //for
 } //RandomizeTableNormal
 
 /// Fill the gradient/value table `m_fTable` using a cosine distribution.
-/// The source of randomness is `std::default_random_engine`
-/// with `std::uniform_real_distribution<float>(0.0f, 1.0f)`.
+/// The source of randomness is `uniform()`.
 /// It simply multiplies the each pseudo-random number by \f$pi\f$ and
 /// enters the cosine of the result into the table.
 
 void CPerlinNoise2D::RandomizeTableCos(){  
-  std::uniform_real_distribution<float> d(0.0f, 1.0f);
-
-  for(size_t i=0; i<m_nSize; i++){
-    m_fTable[i] = cosf(PI*d(m_stdRandom));
+  for(size_t i=0; i<m_nTableSize; i++){
+    m_fTable[i] = cosf(PI*uniform(m_nTableStream, i));
     assert(-1.0f <= m_fTable[i] && m_fTable[i] <= 1.0f);
   } //for
 } //RandomizeTableCos
 
-/// Fill the gradient/value table `m_fTable` using an exponential distribution.
-/// The source of randomness is `std::default_random_engine`
-/// with `std::exponential_distribution<float>(8.0f)`. It fills half of the
-/// table with negative gradients and half with positive gradients.
+/// Fill the gradient/value table `m_fTable` using an exponential distribution
+/// with rate 4, clamped to \f$[0, 1]\f$. The source of randomness is
+/// `uniform()`, put through the inverse of the exponential cumulative
+/// distribution function. It fills half of the table with negative gradients
+/// and half with positive gradients.
 
 void CPerlinNoise2D::RandomizeTableExp(){  
-  std::exponential_distribution<float> d(4.0f);
-
-  const size_t half = m_nSize/2;
-
-  for(size_t i=0; i<half; i++) //positive values
-    m_fTable[i] = clamp(0.0f, d(m_stdRandom), 1.0f);
+  const size_t half = m_nTableSize/2;
 
-  for(size_t i=half; i<m_nSize; i++) //negative values
-    m_fTable[i] = -clamp(0.0f, d(m_stdRandom), 1.0f);
+  for(size_t i=0; i<m_nTableSize; i++){
+    const float e = -logf(1.0f - uniform(m_nTableStream, i))/4.0f; //exponential
+    m_fTable[i] = (i < half)? clamp(0.0f, e, 1.0f): -clamp(0.0f, e, 1.0f);
+  } //for
 } //RandomizeTableExp
 
 /// Set `m_fTable` to pseudo-random values in \f$[-1, 1]\f$ according 
-/// to some probability distribution. The pseudo-random number generator is
-/// re-seeded from `m_nSeed` before the table is generated. This means that the
-/// table contents for each table size remains the same until `m_nSeed`
-/// is changed.
+/// to some probability distribution. Each entry depends only on `m_nSeed`,
+/// its index, and the distribution. This means that the table contents for
+/// each table size remains the same until `m_nSeed` is changed. The uniform,
+/// maximal, and midpoint displacement tables use only integer arithmetic and
+/// exactly rounded float operations, so they are the same on any platform.
+/// The cosine, normal, and exponential tables call `cosf()` or `logf()`,
+/// whose last bit may differ between C runtime libraries.
 /// \param d Probability distribution enumerated type.
 
 void CPerlinNoise2D::RandomizeTable(eDistribution d){ 
-  m_stdRandom.seed(m_nSeed); //reset PRNG
   m_eDistribution = d; //current distribution
 
   switch(d){
@@ -236,8 +336,60 @@ void CPerlinNoise2D::RandomizeTable(eDistribution d){
     case eDistribution::Exponential: RandomizeTableExp();   break;
     case eDistribution::Midpoint: RandomizeTableMidpoint(); break;
   } //switch
+
+  std::copy(m_fTable, m_fTable + m_nTableSize, m_fTable0); //save for animation
+  AnimateTable(); //move to the current time
+  QuantizeTable(); //keep the fixed-point table in step
 } //RandomizeTable
 
+/// Copy the gradient/value table `m_fTable` into `m_nTable16` as Q15
+/// fixed-point numbers, that is, multiplied by \f$2^{15} - 1\f$ and
+/// rounded to the nearest 16-bit integer. This table is used by
+/// `generatefixed()`. The rounding is done only once per table entry and
+/// everything downstream of it is integer arithmetic, so fixed-point noise
+/// comes out bit-for-bit the same on every platform and compiler provided
+/// that `m_fTable` does. That holds for the uniform, maximal, and midpoint
+/// displacement distributions at time zero. The cosine, normal, and
+/// exponential tables, and the animated table at any other time, go through
+/// `cosf()`, `sinf()`, or `logf()`, whose last bit may vary between C
+/// runtime libraries, and a single entry that lands on the other side of a
+/// rounding boundary will change the noise. The table-free hash does not use
+/// this table at all (see `zfixed()`).
+
+void CPerlinNoise2D::QuantizeTable(){
+  for(size_t i=0; i<m_nTableSize; i++)
+    m_nTable16[i] = (int16_t)lroundf(32767.0f*m_fTable[i]);
+} //QuantizeTable
+
+/// Set `m_fTable` to the gradient/value table at time `m_dTime` by rotating
+/// the entries of `m_fTable0`. An entry \f$v\f$ is taken to be the
+/// X-coordinate of the point \f$(v, \sqrt{1 - v^2}\cos\psi)\f$ in the unit
+/// disk, for a pseudo-random phase \f$\psi\f$, and that point is rotated
+/// about the origin by a pseudo-random number of turns per unit time
+/// between one half and three halves. The new entry is the X-coordinate of
+/// the rotated point, so it changes smoothly, stays in \f$[-1, 1]\f$, and is
+/// unchanged at time zero. For the uniform distribution this is a point on
+/// the unit sphere projected to the disk, so by Archimedes' hat-box theorem
+/// the entries stay uniformly distributed for all time. Everything that reads
+/// the table, including the batch kernels, animates with no extra
+/// work per point. The table-free hash has no table, so it does not animate.
+
+void CPerlinNoise2D::AnimateTable(){
+  for(size_t i=0; i<m_nTableSize; i++){
+    const float v = m_fTable0[i]; //entry at time zero
+
+    if(m_dTime == 0.0)m_fTable[i] = v; //exact
+
+    else{
+      const float u = sqrtf(1.0f - v*v)*cosf(2.0f*PI*uniform(m_nPhaseStream, i));
+      const double turns = m_dTime*(0.5 + uniform(m_nSpeedStream, i)); //turns so far
+      const float theta = 2.0f*PI*(float)(turns - floor(turns)); //angle
+
+      m_fTable[i] = clamp(-1.0f, v*cosf(theta) + u*sinf(theta), 1.0f);
+    } //else
+  } //for
+} //AnimateTable
+
 /// Double the size of the permutation and gradient/value tables up to
 /// a maximum of `m_nMaxTableSize` and call `Initialize()` to re-initialize.
 /// \return true if the table size changed.
@@ -245,6 +397,8 @@ void CPerlinNoise2D::RandomizeTable(eDistribution d){
 bool CPerlinNoise2D::DoubleTableSize(){
   if(m_nSize < m_nMaxTableSize){
     delete [] m_fTable;
+    delete [] m_fTable0;
+    delete [] m_nTable16;
     delete [] m_nPerm;
   
     m_nSize *= 2; //size must be a power of 2
@@ -262,6 +416,8 @@ bool CPerlinNoise2D::DoubleTableSize(){
 bool CPerlinNoise2D::HalveTableSize(){
   if(m_nSize > m_nMinTableSize){
     delete [] m_fTable;
+    delete [] m_fTable0;
+    delete [] m_nTable16;
     delete [] m_nPerm;
   
     m_nSize /= 2; //size must be a power of 2
@@ -278,6 +434,8 @@ bool CPerlinNoise2D::HalveTableSize(){
 bool CPerlinNoise2D::DefaultTableSize(){
   if(m_nSize != m_nDefTableSize){
     delete [] m_fTable;
+    delete [] m_fTable0;
+    delete [] m_nTable16;
     delete [] m_nPerm;
   
     m_nSize = m_nDefTableSize; 
@@ -290,12 +448,29 @@ bool CPerlinNoise2D::DefaultTableSize(){
 
 /// Set the pseudo-random number generator seed to `timeGetTime()`, the number
 /// of milliseconds since Windows last rebooted. This should be sufficiently
-/// unpredictable to make a good seed.
+/// unpredictable to make a good seed. Elsewhere the low 32 bits of the
+/// steady clock are used instead.
 
 void CPerlinNoise2D::SetSeed(){ 
+#ifdef _WIN32
   m_nSeed = timeGetTime();
+#else
+  m_nSeed = (UINT)std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
 } //SetSeed
 
+/// Set the pseudo-random number generator seed to a fixed value and
+/// randomize the gradient/value table and the permutations from it, so that
+/// the noise depends only on the seed and the noise settings. This is used
+/// to render reproducible images for regression tests.
+/// \param seed PRNG seed.
+
+void CPerlinNoise2D::Reseed(UINT seed){ 
+  m_nSeed = seed;
+  RandomizeTable(m_eDistribution);
+  RandomizePermutation();
+} //Reseed
+
 /// Set the spline function type.
 /// \param d Spline function enumerated type.
 
@@ -310,6 +485,71 @@ void CPerlinNoise2D::SetHash(eHash d){
   m_eHash = d;
 } //SetHash
 
+/// Set the distance used for Worley noise.
+/// \param d Worley noise distance enumerated type.
+
+void CPerlinNoise2D::SetWorley(eWorley d){
+  m_eWorley = d;
+} //SetWorley
+
+/// Set the way that octaves are combined.
+/// \param d Fractal enumerated type.
+
+void CPerlinNoise2D::SetFractal(eFractal d){
+  m_eFractal = d;
+} //SetFractal
+
+/// Set the instruction set used by `generatebatch()`, provided the
+/// processor and operating system support it.
+/// \param isa Instruction set enumerated type.
+/// \return true if the instruction set is supported.
+
+bool CPerlinNoise2D::SetISA(eISA isa){
+  if(!ISASupported(isa))return false;
+
+  m_eISA = isa;
+  m_pKernel = m_pKernelTable[(size_t)isa];
+  return true;
+} //SetISA
+
+/// Set the animation time and move the gradient/value table to it using
+/// `AnimateTable()`. This only touches the table, so it is cheap enough to
+/// call once per frame, but it must not be called while noise is being
+/// generated on another thread.
+/// \param t Animation time.
+
+void CPerlinNoise2D::SetTime(double t){
+  m_dTime = t;
+  AnimateTable();
+  QuantizeTable(); //keep the fixed-point table in step
+} //SetTime
+
+/// Copy the noise settings of another noise generator, that is, everything
+/// except the seed, and re-initialize if the table size is different. The
+/// tables are not randomized unless the table size changes, so the caller
+/// must call `Reseed()` afterwards.
+/// \param other Another noise generator.
+
+void CPerlinNoise2D::CopySettings(const CPerlinNoise2D& other){
+  m_eHash = other.m_eHash;
+  m_eSpline = other.m_eSpline;
+  m_eDistribution = other.m_eDistribution;
+  m_eWorley = other.m_eWorley;
+  m_eFractal = other.m_eFractal;
+  m_dTime = other.m_dTime;
+  SetISA(other.m_eISA);
+
+  if(m_nSize != other.m_nSize){
+    delete [] m_fTable;
+    delete [] m_fTable0;
+    delete [] m_nTable16;
+    delete [] m_nPerm;
+  
+    m_nSize = other.m_nSize; 
+    Initialize();
+  } //if
+} //CopySettings
+
 #pragma endregion Functions that change noise settings
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -319,6 +559,8 @@ void CPerlinNoise2D::SetHash(eHash d){
 
 /// Compute a spline function. Depending on the value of `m_eSpline` this
 /// will be either identity function, a cubic spline, or a quintic spline.
+/// The result is clamped, since rounding can take the quintic spline
+/// slightly over 1 just below 1.
 /// \param x A float in the range \f$[-1, 1]\f$.
 /// \return The spline of \f$\mathsf{x}\f$ in the range \f$[-1, 1]\f$.
 
@@ -332,10 +574,8 @@ inline const float CPerlinNoise2D::spline(float x) const{
     case eSpline::Cubic:   fResult = spline3(x); break;
     case eSpline::Quintic: fResult = spline5(x); break;
   } //switch
-  
-  assert(-1.0f <= fResult && fResult <= 1.0f);
 
-  return fResult;
+  return clamp(-1.0f, fResult, 1.0f); //in case of rounding
 } //spline
 
 /// Perlin's pairing function, which combines two unsigned integers into one.
@@ -360,12 +600,25 @@ inline const size_t CPerlinNoise2D::pairstd(size_t x, size_t y) const{
 } //pairstd
 
 /// Perlin's hash function, which uses a random permutation. Note that this
-/// means that it repeats with a period of `m_nSize`.
+/// means that it repeats with a period of `m_nSize`. If `m_nSize` is larger
+/// than `m_nBlockSize`, then a permutation table would no longer fit in the
+/// L1 cache, so a two-level permutation is used instead. The
+/// number is split into low and high bits. The low bits are XORed with a key
+/// chosen by the high bits and permuted. Then the high bits are XORed with a
+/// key chosen by the new low bits and permuted. Each step is invertible, so
+/// the result is a permutation. None of the four small tables it uses has
+/// more than `m_nBlockSize` entries.
 /// \param x A number.
 /// \return Hashed number in the range [0, `m_nSize` - 1].
 
 inline const size_t CPerlinNoise2D::hash(size_t x) const{
-  return m_nPerm[x & m_nMask];
+  if(m_nHiMask == 0) //one-level permutation
+    return m_nPerm[x & m_nMask];
+
+  const size_t hi = (x >> m_nBlockBits) & m_nHiMask; //high bits
+  const size_t lo = m_nPermLo[(x & (m_nBlockSize - 1)) ^ m_nKeyHi[hi]]; //new low bits
+
+  return (size_t)m_nPermHi[hi ^ m_nKeyLo[lo]] << m_nBlockBits | lo;
 } //hash
 
 /// A hash function using `std::hash`. Note: The C++ Standard does not require
@@ -396,6 +649,54 @@ inline const size_t CPerlinNoise2D::hash2(size_t x, size_t y) const{
   return size_t(h >> 8) & m_nMask; //shift and mask
 } //hash2
 
+/// A table-free 2D hash function. The coordinates are multiplied by large odd
+/// constants, combined with the seed, and thoroughly mixed using the
+/// finalizer from MurmurHash3 so that every input bit affects every output
+/// bit. Unlike the other hash functions the result is not masked, so it
+/// repeats only when the coordinates wrap around. The 64-bit result is folded
+/// down to 32 bits so that it is the same for 32-bit and 64-bit builds.
+/// \param x A number.
+/// \param y A number.
+/// \return Hashed number in the range \f$[0, 2^{32} - 1]\f$.
+
+inline const size_t CPerlinNoise2D::hashfree(size_t x, size_t y) const{
+  uint64_t h = 0x9E3779B97F4A7C15ULL*(uint64_t)x ^
+    0xC2B2AE3D27D4EB4FULL*(uint64_t)y ^ m_nSeed; //combine
+  
+  h ^= h >> 33; h *= 0xFF51AFD7ED558CCDULL; //mix
+  h ^= h >> 33; h *= 0xC4CEB9FE1A85EC53ULL; //mix again
+  h ^= h >> 33;
+
+  return size_t((h ^ (h >> 32)) & 0xFFFFFFFF); //fold to 32 bits
+} //hashfree
+
+/// A 2D hash function that combines three small permutations of sizes 251,
+/// 256, and 257. Each permutation hashes the point the same way that
+/// Perlin's `pair()` and `hash()` do, but modulo its own size. Since the sizes
+/// are coprime, the result repeats only every \f$251 \times 256 \times 257\f$
+/// (about 16.5 million) lattice units in each direction, while the
+/// permutations together take up only 3KB and stay in the L1 cache. The three
+/// results are used as the digits of a mixed-radix number less than
+/// \f$251 \times 256 \times 257\f$, with the odd radices 251 and 257 at the
+/// bottom so that every digit contributes to the least significant bits.
+/// That number is then reduced modulo `m_nSize`, which is at most \f$2^{20}\f$,
+/// so every table entry is reachable at every table size.
+/// \param x A number.
+/// \param y A number.
+/// \return Hashed number in the range [0, `m_nSize` - 1].
+
+inline const size_t CPerlinNoise2D::hashcoprime(size_t x, size_t y) const{
+  size_t a = m_nPerm251[x%251] + y%251; //less than 2*251
+  if(a >= 251)a -= 251; //cheaper than another remainder
+
+  size_t c = m_nPerm257[x%257] + y%257; //less than 2*257
+  if(c >= 257)c -= 257; //cheaper than another remainder
+
+  const size_t b = m_nPerm256[(m_nPerm256[x & 255] + y) & 255];
+
+  return (m_nPerm251[a] + 251*(m_nPerm257[c] + 257*b)) & m_nMask;
+} //hashcoprime
+
 /// Get hash values at grid corners (at whole number coordinates).
 /// \param x X-coordinate.
 /// \param y Y-coordinate.
@@ -417,15 +718,149 @@ void CPerlinNoise2D::HashCorners(size_t x, size_t y, size_t c[4]) const{
       c[0] = hashstd(pairstd(x, y));     c[1] = hashstd(pairstd(x + 1, y));
       c[2] = hashstd(pairstd(x, y + 1)); c[3] = hashstd(pairstd(x + 1, y + 1));
     break;
+
+    case eHash::Stateless:
+      c[0] = hashfree(x, y);     c[1] = hashfree(x + 1, y);
+      c[2] = hashfree(x, y + 1); c[3] = hashfree(x + 1, y + 1);
+    break;
+
+    case eHash::Coprime:
+      c[0] = hashcoprime(x, y);     c[1] = hashcoprime(x + 1, y);
+      c[2] = hashcoprime(x, y + 1); c[3] = hashcoprime(x + 1, y + 1);
+    break;
   } //switch
 } //HashCorners
 
+/// Get the hash value at a single grid point (at whole number coordinates).
+/// This gives the same value as the corresponding corner in `HashCorners()`.
+/// \param x X-coordinate.
+/// \param y Y-coordinate.
+/// \return Hash value.
+
+inline const size_t CPerlinNoise2D::hashpoint(size_t x, size_t y) const{
+  switch(m_eHash){
+    case eHash::Permutation:        return hash(pair(x, y));
+    case eHash::LinearCongruential: return hash2(x, y);
+    case eHash::Std:                return hashstd(pairstd(x, y));
+    case eHash::Stateless:          return hashfree(x, y);
+    case eHash::Coprime:            return hashcoprime(x, y);
+    default:                        return 0;
+  } //switch
+} //hashpoint
+
+/// Get the hash value that the second channel of a warp field uses in place
+/// of a given hash value, so that both channels can share the corner hashes.
+/// For the table hashes it is offset by half of the table size, so that it
+/// picks a different gradient from the table even if the permutation is
+/// larger than the table. The table-free hash is remixed instead, since
+/// its bits are used directly by `zfree()`.
+/// \param h Hash value.
+/// \return Hash value for the second channel.
+
+inline const size_t CPerlinNoise2D::rekey(size_t h) const{
+  if(m_eHash == eHash::Stateless)
+    return ((h ^ (h >> 16))*0x9E3779B1) & 0xFFFFFFFF; //odd multiplier
+
+  return (h + (m_nTableSize >> 1)) & m_nMask;
+} //rekey
+
+/// Turn 16 hash bits into a pseudo-random number in \f$[-1, 1]\f$ drawn from
+/// the current distribution `m_eDistribution`, without using a table. The bits
+/// are first mapped to a uniform number \f$u \in [-1, 1]\f$, which is then
+/// put through an approximation to the inverse of the cumulative distribution
+/// function. Both ends are reachable, from hash bits 0 and `0xFFFF`, so the
+/// normal and exponential distributions clamp their infinite tails. The
+/// results have the same distributions as the table entries made by the
+/// corresponding `RandomizeTable` functions. Midpoint displacement only makes
+/// sense for a table, so it gets the uniform distribution.
+/// \param h Hash bits, only the least significant 16 of which are used.
+/// \return Pseudo-random number in \f$[-1, 1]\f$.
+
+inline const float CPerlinNoise2D::shape(size_t h) const{
+  const float u = ((h & 0xFFFF) - 32767.5f)/32767.5f; //uniform in [-1, 1]
+  float result = u; //for the result
+
+  switch(m_eDistribution){
+    case eDistribution::Uniform:
+    case eDistribution::Midpoint:
+    break;
+
+    case eDistribution::Maximal:
+      result = (u > 0.0f)? 1.0f: -1.0f;
+    break;
+
+    case eDistribution::Cosine: { //sin(pi*u/2) is distributed like cos(pi*v)
+      const float u2 = u*u; //u squared
+      result = u*(1.5707963f - u2*(0.6459641f - u2*(0.0796926f -
+        u2*0.0046817f))); //Taylor polynomial
+    } //case
+    break;
+
+    case eDistribution::Normal: { //sqrt(2)*erfinv(u), Giles' approximation
+      const float v = std::max<float>((1.0f - u)*(1.0f + u), 1.0e-6f); //not 0
+      float w = -logf(v); //tail parameter
+      float p = 0.0f; //for the polynomial
+
+      if(w < 5.0f){ //central region
+        w -= 2.5f;
+        p =  2.81022636e-08f;         p =  3.43273939e-07f + p*w;
+        p = -3.5233877e-06f  + p*w;   p = -4.39150654e-06f + p*w;
+        p =  0.00021858087f  + p*w;   p = -0.00125372503f  + p*w;
+        p = -0.00417768164f  + p*w;   p =  0.246640727f    + p*w;
+        p =  1.50140941f     + p*w;
+      } //if
+
+      else{ //tails
+        w = sqrtf(w) - 3.0f;
+        p = -0.000200214257f;         p =  0.000100950558f + p*w;
+        p =  0.00134934322f  + p*w;   p = -0.00367342844f  + p*w;
+        p =  0.00573950773f  + p*w;   p = -0.0076224613f   + p*w;
+        p =  0.00943887047f  + p*w;   p =  1.00167406f     + p*w;
+        p =  2.83297682f     + p*w;
+      } //else
+
+      result = clamp(-1.0f, 0.4f*1.41421356f*p*u, 1.0f); //mean 0, sd 0.4
+    } //case
+    break;
+
+    case eDistribution::Exponential: { //sign of u times exponential in |u|
+      const float v = clamp(0.0f, -logf(1.0f - fabsf(u))/4.0f, 1.0f);
+      result = (u < 0.0f)? -v: v;
+    } //case
+    break;
+  } //switch
+
+  assert(-1.0f <= result && result <= 1.0f);
+  return result;
+} //shape
+
+/// Table-free equivalent of `z()`. For Perlin noise, the X and Y gradients
+/// are made from the most and least significant 16 bits of the hash value,
+/// respectively. For Value noise, the value is made from the most
+/// significant 16 bits.
+/// \param h Hash value from `hashfree()`.
+/// \param x X-coordinate of point in the range \f$[-1, 1]\f$.
+/// \param y Y-coordinate of point in the range \f$[-1, 1]\f$.
+/// \param t Noise type.
+/// \return Corresponding Z-value.
+
+inline const float CPerlinNoise2D::zfree(size_t h, float x, float y, eNoise t)
+  const
+{
+  switch(t){ //noise type
+    case eNoise::Perlin: return x*shape(h >> 16) + y*shape(h);
+    case eNoise::Value:  return shape(h >> 16);
+    default: return 0.0f;
+  } //switch
+} //zfree
+
 /// For Perlin noise, multiply hashed gradient from `m_fTable` by coordinates. 
 /// Use the hash value parameter to index into the gradient table for the
 /// X gradient and rehash it for the index of the Y gradient. Add these
 /// gradients multiplied by the fractional values of the position (that is,
 /// return \f$z = x \frac{dz}{dx} + y\frac{dz}{dy}\f$). For Value noise, just
-/// read the \f$z\f$ value directly from the table.
+/// read the \f$z\f$ value directly from the table. The gradient table has
+/// at most `m_nBlockSize` entries, so hash values are masked down to fit.
 /// \param h Hash value for gradient table index.
 /// \param x X-coordinate of point in the range \f$[-1, 1]\f$.
 /// \param y Y-coordinate of point in the range \f$[-1, 1]\f$.
@@ -435,20 +870,26 @@ void CPerlinNoise2D::HashCorners(size_t x, size_t y, size_t c[4]) const{
 inline const float CPerlinNoise2D::z(size_t h, float x, float y, eNoise t) const{
   assert(-1.0f <= x && x <= 1.0f);
   assert(-1.0f <= y && y <= 1.0f);
+
+  if(m_eHash == eHash::Stateless)
+    return zfree(h, x, y, t);
+
   assert(h == (h & m_nMask)); 
 
   float result = 0; //return result
 
   switch(t){ //noise type
-    case eNoise::Perlin: 
-      result = x*m_fTable[h] + y*m_fTable[hash(h)]; //gradient times position
+    case eNoise::Perlin: //gradient times position
+      result = x*m_fTable[h & m_nTableMask] + y*m_fTable[hash(h) & m_nTableMask];
       assert(-2.0f <= result && result <= 2.0f);
     break;
       
     case eNoise::Value:
-      result = m_fTable[h]; //get value directly from table
+      result = m_fTable[h & m_nTableMask]; //get value directly from table
       assert(-1.0f <= result && result <= 1.0f);
     break;
+
+    default: break;
   } //switch
 
   return result; 
@@ -497,28 +938,41 @@ const float CPerlinNoise2D::Lerp(float sX, float fX, float fY, size_t* c,
 
 #pragma region Noise generation functions
 
-/// Compute a single octave of Perlin or Value noise at a 2D point.
-/// \param x X-coordinate of point.
-/// \param y Y-coordinate of point.
+/// Compute a single octave of Perlin or Value noise at a 2D point. The point
+/// is given as the integer coordinates of the lattice cell that contains it
+/// together with its fractional offset within that cell. Carrying the integer
+/// part separately means that the fractional part keeps full float precision
+/// no matter how far the point is from the origin.
+/// \param nX Integer part of the X-coordinate of point.
+/// \param nY Integer part of the Y-coordinate of point.
+/// \param fX Fractional part of the X-coordinate of point, in \f$[0, 1]\f$.
+/// \param fY Fractional part of the Y-coordinate of point, in \f$[0, 1]\f$.
 /// \param t Noise type.
 /// \return A smoothed noise value in [-1, 1] at the given point.
 
-const float CPerlinNoise2D::noise(float x, float y, eNoise t) const{
-  const size_t nX = (size_t)floorf(x); //integer part of x
-  const size_t nY = (size_t)floorf(y); //integer part of y
+const float CPerlinNoise2D::noise(int64_t nX, int64_t nY, float fX, float fY,
+  eNoise t) const
+{
+  if(t == eNoise::Simplex)
+    return simplex(nX, nY, fX, fY);
 
-  const float fX = x - floorf(x); //fractional part of x
-  const float fY = y - floorf(y); //fractional part of y
+  if(t == eNoise::Worley)
+    return worley(nX, nY, fX, fY);
+
+  assert(0.0f <= fX && fX <= 1.0f);
+  assert(0.0f <= fY && fY <= 1.0f);
 
   //smooth fractional parts of x and y using spline curves
  
   const float sX = spline(fX); //apply spline curve to fractional part of x
   const float sY = spline(fY); //apply spline curve to fractional part of y
   
-  //hash value at corners of enclosing grid square with integer coordinates
+  //hash value at corners of enclosing grid square with integer coordinates.
+  //Negative coordinates wrap around modulo 2^64, which the hash functions
+  //are happy with since they mask or mix the result anyway.
 
   size_t c[4] = {0}; //for hashed values at corners
-  HashCorners(nX, nY, c); //get hashed values at corners
+  HashCorners((size_t)nX, (size_t)nY, c); //get hashed values at corners
 
   //lerp along the top and bottom along the X-axis
 
@@ -531,7 +985,261 @@ const float CPerlinNoise2D::noise(float x, float y, eNoise t) const{
   assert(-1.0f <= result && result <= 1.0f);
   return result;
 } //noise
+
+/// Compute a single octave of both channels of a two-channel Perlin noise
+/// field at a 2D point, as used for domain warping. The channels are
+/// evaluated at the same point, so the corners are hashed once and the
+/// second channel gets its gradients from the rekeyed hash values
+/// (see `rekey()`).
+/// \param nX Integer part of the X-coordinate of point.
+/// \param nY Integer part of the Y-coordinate of point.
+/// \param fX Fractional part of the X-coordinate of point, in \f$[0, 1]\f$.
+/// \param fY Fractional part of the Y-coordinate of point, in \f$[0, 1]\f$.
+/// \param a [OUT] Noise value for the first channel, in [-1, 1].
+/// \param b [OUT] Noise value for the second channel, in [-1, 1].
+
+void CPerlinNoise2D::noise2(int64_t nX, int64_t nY, float fX, float fY,
+  float& a, float& b) const
+{
+  assert(0.0f <= fX && fX <= 1.0f);
+  assert(0.0f <= fY && fY <= 1.0f);
+
+  const float sX = spline(fX); //apply spline curve to fractional part of x
+  const float sY = spline(fY); //apply spline curve to fractional part of y
+
+  size_t c[4] = {0}; //for hashed values at corners
+  HashCorners((size_t)nX, (size_t)nY, c); //get hashed values at corners
+
+  size_t d[4] = {0}; //for hashed values for the second channel
+  for(size_t i=0; i<4; i++)d[i] = rekey(c[i]);
+
+  a = lerp(sY, Lerp(sX, fX, fY, c, eNoise::Perlin),
+    Lerp(sX, fX, fY - 1, &(c[2]), eNoise::Perlin));
+  b = lerp(sY, Lerp(sX, fX, fY, d, eNoise::Perlin),
+    Lerp(sX, fX, fY - 1, &(d[2]), eNoise::Perlin));
+
+  assert(-1.0f <= a && a <= 1.0f);
+  assert(-1.0f <= b && b <= 1.0f);
+} //noise2
+
+/// Compute a single octave of Simplex noise at a 2D point. The point is given
+/// in skewed coordinates (see `split()`), in which the triangles of the
+/// simplex grid are the two halves of each square lattice cell. The cell is
+/// split along its diagonal into a lower and an upper triangle, and each of
+/// the three corners of the triangle containing the point contributes its
+/// gradient dotted with the offset from that corner (in unskewed coordinates),
+/// attenuated by a radial falloff. The gradients come from `z()` and the
+/// corner hashes from `hashpoint()`, so all of the hash functions, tables, and
+/// distributions apply.
+/// \param nX Integer part of the skewed X-coordinate of point.
+/// \param nY Integer part of the skewed Y-coordinate of point.
+/// \param fX Fractional part of the skewed X-coordinate, in \f$[0, 1]\f$.
+/// \param fY Fractional part of the skewed Y-coordinate, in \f$[0, 1]\f$.
+/// \return A noise value in [-1, 1] at the given point.
+
+const float CPerlinNoise2D::simplex(int64_t nX, int64_t nY, float fX, float fY)
+  const
+{
+  assert(0.0f <= fX && fX <= 1.0f);
+  assert(0.0f <= fY && fY <= 1.0f);
+
+  //offsets from the three corners in unskewed coordinates
+
+  const float g = (fX + fY)*G2; //unskew
+  const float x0 = fX - g; //offset from first corner
+  const float y0 = fY - g; //offset from first corner
+
+  const int64_t i1 = (fX > fY)? 1: 0; //lower triangle steps along X first
+  const int64_t j1 = 1 - i1; //upper triangle steps along Y first
+
+  const float x1 = x0 - (float)i1 + G2; //offset from middle corner
+  const float y1 = y0 - (float)j1 + G2; //offset from middle corner
+  const float x2 = x0 - 1.0f + 2.0f*G2; //offset from last corner
+  const float y2 = y0 - 1.0f + 2.0f*G2; //offset from last corner
+
+  //sum of corner contributions, skipping the hash if the corner is too far
+  //away to contribute anything
+
+  const float x[3] = {x0, x1, x2}, y[3] = {y0, y1, y2};
+  const int64_t di[3] = {0, i1, 1}, dj[3] = {0, j1, 1};
+  float n[3] = {0.0f}; //contributions
+
+  for(size_t k=0; k<3; k++){ //for each corner
+    float t = 0.5f - x[k]*x[k] - y[k]*y[k]; //radial falloff
+
+    if(t > 0.0f){
+      const size_t h = hashpoint((size_t)(nX + di[k]), (size_t)(nY + dj[k]));
+      t *= t;
+      n[k] = t*t*z(h, x[k], y[k], eNoise::Perlin);
+    } //if
+  } //for
+
+  //the largest possible magnitude of the sum is a little over 1/70
+
+  const float result = 70.0f*(n[0] + n[1] + n[2]);
+  assert(-1.0f <= result && result <= 1.0f);
+  return result;
+} //simplex
+
+/// Get the offset of the feature point of a lattice cell from the center of
+/// that cell, in units of `JITTER`. The offsets are read from the gradient
+/// table (or made from the hash bits by the table-free hash) exactly like
+/// the gradients in `z()`, so they follow the current distribution.
+/// \param h Hash value of the cell.
+/// \param x [OUT] X-offset in \f$[-1, 1]\f$.
+/// \param y [OUT] Y-offset in \f$[-1, 1]\f$.
+
+inline void CPerlinNoise2D::feature(size_t h, float& x, float& y) const{
+  if(m_eHash == eHash::Stateless){
+    x = shape(h >> 16); 
+    y = shape(h);
+  } //if
+
+  else{
+    x = m_fTable[h & m_nTableMask];
+    y = m_fTable[hash(h) & m_nTableMask];
+  } //else
+} //feature
+
+/// Compute a single octave of Worley noise at a 2D point. Each lattice cell
+/// has one feature point, placed within `JITTER` of the center of the cell
+/// using the offsets from `feature()` for the cell's hash value. The
+/// distances from the point to the nearest and second nearest feature points
+/// are found by searching the cell containing the point and its eight
+/// neighbors. Since the feature points are at most `JITTER` from their cell
+/// centers, a cell can be skipped without hashing it if no point within that
+/// distance of its center is closer than the distance being computed. The
+/// cells are searched nearest first so that this happens as often as
+/// possible. `JITTER` is small enough that the nearest feature point is
+/// always in the \f$3 \times 3\f$ neighborhood.
+/// \param nX Integer part of the X-coordinate of point.
+/// \param nY Integer part of the Y-coordinate of point.
+/// \param fX Fractional part of the X-coordinate of point, in \f$[0, 1]\f$.
+/// \param fY Fractional part of the Y-coordinate of point, in \f$[0, 1]\f$.
+/// \return A noise value in [-1, 1] at the given point.
+
+const float CPerlinNoise2D::worley(int64_t nX, int64_t nY, float fX, float fY)
+  const
+{
+  assert(0.0f <= fX && fX <= 1.0f);
+  assert(0.0f <= fY && fY <= 1.0f);
+
+  static const int64_t di[9] = {0, -1, 1,  0, 0, -1,  1, -1, 1}; //cell offsets
+  static const int64_t dj[9] = {0,  0, 0, -1, 1, -1, -1,  1, 1}; //nearest first
+
+  const float r = JITTER + 1.0e-4f; //rounded up so that pruning is safe
+  const bool bF1 = m_eWorley == eWorley::F1; //only need the nearest
+
+  float f1 = 8.0f; //squared distance to nearest feature point
+  float f2 = 8.0f; //squared distance to second nearest feature point
+
+  for(size_t k=0; k<9; k++){ //for each cell in the neighborhood
+    const float cx = (float)di[k] + 0.5f - fX; //offset to cell center
+    const float cy = (float)dj[k] + 0.5f - fY; //offset to cell center
+    const float gx = std::max<float>(0.0f, fabsf(cx) - r); //gap to feature point
+    const float gy = std::max<float>(0.0f, fabsf(cy) - r); //gap to feature point
+
+    if(gx*gx + gy*gy >= (bF1? f1: f2))continue; //prune
+
+    float x, y; //feature point offset
+    feature(hashpoint((size_t)(nX + di[k]), (size_t)(nY + dj[k])), x, y);
+
+    const float dx = (float)di[k] + 0.5f + JITTER*x - fX;
+    const float dy = (float)dj[k] + 0.5f + JITTER*y - fY;
+    const float d = dx*dx + dy*dy; //squared distance to feature point
+
+    if(d < f1){f2 = f1; f1 = d;}
+    else if(d < f2)f2 = d;
+  } //for
+
+  float result = 0.0f; //distance
+
+  switch(m_eWorley){
+    case eWorley::F1:        result = sqrtf(f1); break;
+    case eWorley::F2:        result = sqrtf(f2); break;
+    case eWorley::F2MinusF1: result = sqrtf(f2) - sqrtf(f1); break;
+  } //switch
+
+  //the distances are at most about 4/3, so this maps them into [-1, 1]
+
+  return clamp(-1.0f, 1.5f*result - 1.0f, 1.0f);
+} //worley
+
+/// Split a point into the integer coordinates of the lattice cell that
+/// contains it and its fractional offset within that cell. For Simplex noise
+/// the point is skewed first so that the simplex grid lines up with the
+/// square lattice. The skew is linear, so the octaves can be scaled in skewed
+/// coordinates by `scale()` just as for the other noise types.
+/// \param x X-coordinate of point.
+/// \param y Y-coordinate of point.
+/// \param t Noise type.
+/// \param nX [OUT] Integer part of X-coordinate.
+/// \param nY [OUT] Integer part of Y-coordinate.
+/// \param fX [OUT] Fractional part of X-coordinate, in \f$[0, 1]\f$.
+/// \param fY [OUT] Fractional part of Y-coordinate, in \f$[0, 1]\f$.
+
+inline void CPerlinNoise2D::split(double x, double y, eNoise t, int64_t& nX,
+  int64_t& nY, float& fX, float& fY) const
+{
+  if(t == eNoise::Simplex){ //skew
+    const double s = (x + y)*F2;
+    x += s; y += s;
+  } //if
+
+  nX = (int64_t)floor(x); //integer part of x
+  nY = (int64_t)floor(y); //integer part of y
+
+  fX = (float)(x - (double)nX); //fractional part of x
+  fY = (float)(y - (double)nY); //fractional part of y
+} //split
+
+/// Multiply a lattice coordinate, given as an integer part and a fractional
+/// part, by the persistence. The product is computed in double precision and
+/// then split again into an integer part and a fractional part, so that no
+/// precision is lost in the fractional part however large the integer
+/// part gets. If the persistence is a whole number (which it usually is),
+/// then the integer part is scaled exactly.
+/// \param n [IN, OUT] Integer part of coordinate.
+/// \param f [IN, OUT] Fractional part of coordinate, in \f$[0, 1]\f$.
+/// \param beta Persistence.
+
+inline void CPerlinNoise2D::scale(int64_t& n, float& f, float beta) const{
+  const double d = (double)beta*n; //scaled integer part
+  const double c = floor(d); //whole part of that
+  const double g = (d - c) + (double)beta*f; //what's left over, may exceed 1
+  const double k = floor(g); //whole part of what's left over
+
+  n = (int64_t)c + (int64_t)k;
+  f = (float)(g - k);
+} //scale
   
+/// Transform a single octave of noise for the current fractal type
+/// `m_eFractal`. For the ridged multifractal, the octave is inverted and
+/// squared so that its zero crossings become sharp ridges, then multiplied by
+/// a weight that is carried from octave to octave. The next weight is twice
+/// the result, clamped to \f$[0, 1]\f$, so that the finer octaves only
+/// add detail near the ridges of the coarser ones.
+/// \param n Noise value in \f$[-1, 1]\f$.
+/// \param weight [IN, OUT] Ridged multifractal weight, which must start at 1.
+/// \return Transformed noise value in \f$[-1, 1]\f$.
+
+inline const float CPerlinNoise2D::fractal(float n, float& weight) const{
+  switch(m_eFractal){
+    case eFractal::Turbulence: return fabsf(n);
+    case eFractal::Billow:     return 2.0f*fabsf(n) - 1.0f;
+
+    case eFractal::Ridged: {
+      float s = 1.0f - fabsf(n); //invert so that ridges are high
+      s = s*s; //sharpen ridges
+      s = s*weight; //weight by previous octave
+      weight = clamp(0.0f, 2.0f*s, 1.0f);
+      return s;
+    } //case
+
+    default: return n;
+  } //switch
+} //fractal
+
 /// Add multiple octaves of Perlin or Value noise to compute an effect similar
 /// to turbulence at a single point. Each successive octave has its amplitude
 /// multiplied by a value called the _lacunarity_ and its frequency multiplied
@@ -547,29 +1255,882 @@ const float CPerlinNoise2D::noise(float x, float y, eNoise t) const{
 
 const float CPerlinNoise2D::generate(float x, float y, eNoise t, size_t n, 
   float alpha, float beta) const
+{
+  return generate((double)x, (double)y, t, n, alpha, beta);
+} //generate
+
+/// Add multiple octaves of Perlin or Value noise at a point given in double
+/// precision. The point is split once into a 64-bit integer lattice cell and
+/// a float fraction, and each octave scales both using `scale()` instead of
+/// multiplying a float coordinate by the persistence. This means that the
+/// noise looks the same and takes the same time to compute whether the point
+/// is near the origin or a billion units away from it.
+/// \param x X-coordinate of a 2D point.
+/// \param y Y-coordinate of a 2D point.
+/// \param t Noise type.
+/// \param n Number of octaves.
+/// \param alpha Lacunarity. Defaults to 0.5f.
+/// \param beta Persistence. Defaults to 2.0f.
+/// \return Smooth noise in \f$[-1, 1]\f$ at point \f$(\mathsf{x}, \mathsf{y})\f$.
+
+const float CPerlinNoise2D::generate(double x, double y, eNoise t, size_t n, 
+  float alpha, float beta) const
 {
   assert(0.0f <= alpha && alpha < 1.0f);
   assert(beta > 1.0f);
 
+  int64_t nX, nY; //integer parts
+  float fX, fY; //fractional parts
+  split(x, y, t, nX, nY, fX, fY);
+
   float sum = 0.0f; //for result
   float amplitude = 1.0f; //octave amplitude
 
+  float weight = 1.0f; //ridged multifractal weight
+
   for(size_t i=0; i<n; i++){ //for each octave
-    sum += amplitude*noise(x, y, t); //scale noise by amplitude
+    const float v = fractal(noise(nX, nY, fX, fY, t), weight); //octave
+    sum += amplitude*v; //scale noise by amplitude
     amplitude *= alpha; //reduce amplitude by lacunarity  
-    x *= beta; y *= beta; //multiply frequency by persistence
+    scale(nX, fX, beta); scale(nY, fY, beta); //multiply frequency by persistence
   } //for
 
-  assert(amplitude == powf(alpha, (float)n));
+  assert(fabsf(amplitude - powf(alpha, (float)n)) <= n*1.0e-7f); //rounding
+
+  return normalize(sum, amplitude, alpha, t);
+} //generate
+
+/// Add multiple octaves of Perlin or Value noise at a point, leaving out
+/// the octaves that are too fine to be represented at a given sampling rate.
+/// The caller passes the distance between samples (the pixel footprint) in
+/// noise coordinates. An octave whose lattice cells are less than two samples
+/// wide is above the Nyquist limit and only adds aliasing, so it is skipped,
+/// as are all of the higher octaves. An octave whose lattice cells are between
+/// two and four samples wide is faded out linearly so that zooming doesn't
+/// make octaves pop in and out. The octave sum is normalized exactly as in
+/// `generate()` for all `n` octaves, so the overall brightness doesn't shift.
+/// \param x X-coordinate of a 2D point.
+/// \param y Y-coordinate of a 2D point.
+/// \param footprint Distance between samples in noise coordinates.
+/// \param t Noise type.
+/// \param n Maximum number of octaves.
+/// \param alpha Lacunarity. Defaults to 0.5f.
+/// \param beta Persistence. Defaults to 2.0f.
+/// \return Smooth noise in \f$[-1, 1]\f$ at point \f$(\mathsf{x}, \mathsf{y})\f$.
+
+const float CPerlinNoise2D::generate(double x, double y, float footprint,
+  eNoise t, size_t n, float alpha, float beta) const
+{
+  assert(footprint > 0.0f);
+  assert(0.0f <= alpha && alpha < 1.0f);
+  assert(beta > 1.0f);
+
+  int64_t nX, nY; //integer parts
+  float fX, fY; //fractional parts
+  split(x, y, t, nX, nY, fX, fY);
+
+  float sum = 0.0f; //for result
+  float amplitude = 1.0f; //octave amplitude
+  float cells = footprint; //lattice cells per sample in this octave
+  float ridge = 1.0f; //ridged multifractal weight
+
+  for(size_t i=0; i<n; i++){ //for each octave
+    const float weight = clamp(0.0f, 2.0f - 4.0f*cells, 1.0f); //fade out
+    if(weight == 0.0f)break; //this octave and all the rest are above Nyquist
+
+    const float v = fractal(noise(nX, nY, fX, fY, t), ridge); //octave
+    sum += weight*amplitude*v; //scale noise by amplitude
+    amplitude *= alpha; //reduce amplitude by lacunarity  
+    cells *= beta; //octave cells shrink with frequency
+    scale(nX, fX, beta); scale(nY, fY, beta); //multiply frequency by persistence
+  } //for
+
+  return normalize(sum, powf(alpha, (float)n), alpha, t);
+} //generate
+
+/// Generate a pyramid of band-limited noise images (a mip chain) in a single
+/// pass. Level 0 is `w` \f$\times\f$ `h` samples spaced `footprint` apart
+/// starting at \f$(\mathsf{x}, \mathsf{y})\f$, and level \f$k\f$ has half the
+/// width and height of level \f$k - 1\f$ with twice the sample spacing.
+/// Sample \f$(i, j)\f$ of level \f$k\f$ is at the same point as sample
+/// \f$(2^ki, 2^kj)\f$ of level 0, and level \f$k\f$ is band-limited in the
+/// same way as `generate(double, double, float, eNoise, size_t, float, float)`
+/// for its own sample spacing, that is, it contains only a prefix of
+/// the octaves of level 0. So each octave is computed once per level 0
+/// sample and the coarser levels are just differently weighted sums of the
+/// same octaves. The image is traversed in square tiles so that the writes
+/// to all levels stay close together in memory.
+/// \param level Array of `levels` pointers to row-major images, level
+/// \f$k\f$ being of size `w` \f$/2^k \times\f$ `h` \f$/2^k\f$ (rounded down).
+/// \param w Width of level 0.
+/// \param h Height of level 0.
+/// \param levels Number of levels.
+/// \param x X-coordinate of the first sample.
+/// \param y Y-coordinate of the first sample.
+/// \param footprint Distance between samples of level 0 in noise coordinates.
+/// \param t Noise type.
+/// \param n Maximum number of octaves.
+/// \param alpha Lacunarity. Defaults to 0.5f.
+/// \param beta Persistence. Defaults to 2.0f.
+
+void CPerlinNoise2D::generatepyramid(float** level, size_t w, size_t h,
+  size_t levels, double x, double y, float footprint, eNoise t, size_t n, 
+  float alpha, float beta) const
+{
+  assert(footprint > 0.0f);
+  assert(0.0f <= alpha && alpha < 1.0f);
+  assert(beta > 1.0f);
+  assert(levels > 0 && (w >> (levels - 1)) > 0 && (h >> (levels - 1)) > 0);
+
+  //octave weights for each level, scaled by the octave amplitude
+
+  std::vector<float> weight(levels*n, 0.0f); //weight of octave i at level k
+  size_t m = 0; //number of octaves needed for level 0
+
+  for(size_t k=0; k<levels; k++){
+    float amplitude = 1.0f; //octave amplitude
+    float cells = footprint*(float)(1 << k); //lattice cells per sample
+
+    for(size_t i=0; i<n; i++){
+      const float f = clamp(0.0f, 2.0f - 4.0f*cells, 1.0f); //fade out
+      weight[k*n + i] = f*amplitude;
+      if(k == 0 && f > 0.0f)m = i + 1;
+      amplitude *= alpha; 
+      cells *= beta;
+    } //for
+  } //for
+
+  const float amplitude = powf(alpha, (float)n); //for normalization
+  std::vector<float> octave(n, 0.0f); //noise value for each octave
+
+  //tiled traversal of level 0, the tile size being a multiple of the
+  //spacing of the coarsest level
+
+  const size_t tile = std::max<size_t>(64, (size_t)1 << (levels - 1)); 
+
+  for(size_t i0=0; i0<h; i0+=tile)
+    for(size_t j0=0; j0<w; j0+=tile)
+      for(size_t i=i0; i<std::min<size_t>(i0 + tile, h); i++)
+        for(size_t j=j0; j<std::min<size_t>(j0 + tile, w); j++){
+          int64_t nX, nY; //integer parts
+          float fX, fY; //fractional parts
+          split(x + j*(double)footprint, y + i*(double)footprint, t,
+            nX, nY, fX, fY);
+
+          float ridge = 1.0f; //ridged multifractal weight
+
+          for(size_t o=0; o<m; o++){ //octaves needed for level 0
+            octave[o] = fractal(noise(nX, nY, fX, fY, t), ridge);
+            scale(nX, fX, beta); scale(nY, fY, beta);
+          } //for
+
+          //this sample is in level k if its indices are multiples of 2^k
+          //and in range for that level
+
+          for(size_t k=0; k<levels; k++){
+            const size_t mask = ((size_t)1 << k) - 1;
+            if((i & mask) || (j & mask))break; //not in this or coarser levels
+            if((i >> k) >= (h >> k) || (j >> k) >= (w >> k))break; //out of range
+
+            const float* wt = &weight[k*n]; //weights for this level
+            float sum = 0.0f; //weighted sum of octaves
+
+            for(size_t o=0; o<m; o++)
+              sum += wt[o]*octave[o];
+
+            level[k][(i >> k)*(w >> k) + (j >> k)] =
+              normalize(sum, amplitude, alpha, t);
+          } //for
+        } //for
+} //generatepyramid
+
+/// Fill in the kernel arguments that describe the hash, the table, and the
+/// noise settings. The caller fills in the rest.
+/// \param args [OUT] Kernel arguments.
+
+void CPerlinNoise2D::InitKernelArgs(KernelArgs& args) const{
+  args.pPerm = m_nPerm;
+  args.pPermLo = m_nPermLo; args.pPermHi = m_nPermHi;
+  args.pKeyLo = m_nKeyLo; args.pKeyHi = m_nKeyHi;
+  args.pTable = m_fTable;
+  args.nMask = (int32_t)m_nMask;
+  args.nTableMask = (int32_t)m_nTableMask;
+  args.nHiMask = (int32_t)m_nHiMask;
+  args.nBlockBits = (int32_t)m_nBlockBits;
+  args.eSplineType = m_eSpline;
+  args.eWorleyType = m_eWorley;
+  args.eFractalType = m_eFractal;
+} //InitKernelArgs
+
+/// Split a chunk of points into masked lattice cells and fractional parts
+/// for the batch kernel, exactly as `generate()` would, padding with zeros.
+/// \param x Array of X-coordinates.
+/// \param y Array of Y-coordinates.
+/// \param m Number of points.
+/// \param count Number of points after padding, at least `m`.
+/// \param t Noise type.
+/// \param nX [OUT] Array of `count` masked cell X-coordinates.
+/// \param nY [OUT] Array of `count` masked cell Y-coordinates.
+/// \param fX [OUT] Array of `count` fractional parts of X-coordinates.
+/// \param fY [OUT] Array of `count` fractional parts of Y-coordinates.
+
+void CPerlinNoise2D::SplitBatch(const double* x, const double* y, size_t m,
+  size_t count, eNoise t, int32_t* nX, int32_t* nY, float* fX, float* fY) const
+{
+  for(size_t i=0; i<count; i++){ //split into cell and fraction
+    const double dX = (i < m)? x[i]: 0.0; //pad with zeros
+    const double dY = (i < m)? y[i]: 0.0; //pad with zeros
+    int64_t cX, cY; //integer parts
+
+    split(dX, dY, t, cX, cY, fX[i], fY[i]);
+    nX[i] = (int32_t)(cX & (int64_t)m_nMask);
+    nY[i] = (int32_t)(cY & (int64_t)m_nMask);
+  } //for
+} //SplitBatch
+
+/// Add multiple octaves of Perlin or Value noise at each of a batch of points.
+/// If the permutation hash is being used with a persistence of 2, then this
+/// is done by the batch kernel `m_pKernel` for the instruction set chosen
+/// by `SetISA()`, a chunk of points at a time. Each point is split into its
+/// lattice cell and fractional part exactly as in `generate()` and the
+/// kernels perform the same operations in the same order, so the results are
+/// the same as calling `generate()` for each point, which is what
+/// happens otherwise.
+/// \param x Array of X-coordinates.
+/// \param y Array of Y-coordinates.
+/// \param count Number of points.
+/// \param result [OUT] Array of `count` noise values in \f$[-1, 1]\f$.
+/// \param t Noise type.
+/// \param n Number of octaves.
+/// \param alpha Lacunarity. Defaults to 0.5f.
+/// \param beta Persistence. Defaults to 2.0f.
+
+void CPerlinNoise2D::generatebatch(const double* x, const double* y,
+  size_t count, float* result, eNoise t, size_t n, float alpha, float beta)
+  const
+{
+  if(m_pKernel == nullptr || m_eHash != eHash::Permutation || beta != 2.0f ||
+    t == eNoise::None)
+  {
+    for(size_t i=0; i<count; i++) //one at a time
+      result[i] = generate(x[i], y[i], t, n, alpha, beta);
+    return;
+  } //if
+
+  const size_t nChunk = 256; //points per chunk, a multiple of 16
+
+  int32_t nX[nChunk], nY[nChunk]; //masked lattice cells
+  float fX[nChunk], fY[nChunk]; //fractional parts
+  float sum[nChunk]; //octave sums
+
+  KernelArgs args; //kernel arguments
+  InitKernelArgs(args);
+
+  args.eNoiseType = t;
+  args.nOctaves = n;
+  args.fAlpha = alpha;
+  args.pCellX = nX; args.pCellY = nY;
+  args.pFracX = fX; args.pFracY = fY;
+  args.pSum = sum;
+
+  float amplitude = 1.0f; //amplitude after the last octave
+  for(size_t i=0; i<n; i++)amplitude *= alpha;
+
+  for(size_t i0=0; i0<count; i0+=nChunk){ //for each chunk
+    const size_t m = std::min<size_t>(nChunk, count - i0); //points in this chunk
+    args.nCount = (m + 15) & ~(size_t)15; //round up to a multiple of 16
+
+    SplitBatch(x + i0, y + i0, m, args.nCount, t, nX, nY, fX, fY);
+    m_pKernel(args); //the heavy lifting
+
+    for(size_t i=0; i<m; i++)
+      result[i0 + i] = normalize(sum[i], amplitude, alpha, t);
+  } //for
+} //generatebatch
+
+/// Check whether another generator has the same lattice as this one, that is,
+/// whether it hashes every point to the same gradient/value table indices
+/// with the same spline weights and fractal transform, so that it differs
+/// from this one only in the contents of its table.
+/// \param other Another noise generator.
+/// \return true If the lattices are the same.
+
+const bool CPerlinNoise2D::SharesLattice(const CPerlinNoise2D& other) const{
+  if(&other == this)return true;
+
+  if(m_eHash != other.m_eHash || m_eSpline != other.m_eSpline ||
+    m_eFractal != other.m_eFractal || m_nSize != other.m_nSize ||
+    m_nTableSize != other.m_nTableSize)
+      return false;
+
+  const size_t n = (m_nHiMask == 0)? m_nSize:
+    2*(m_nBlockSize + m_nHiMask + 1); //size of permutation, see Initialize()
+
+  return memcmp(m_nPerm, other.m_nPerm, n*sizeof(uint32_t)) == 0;
+} //SharesLattice
+
+/// Add multiple octaves of Perlin or Value noise at each of a batch of points
+/// for several noise generators at once, for example the same seed with each
+/// of the probability distributions. Generators that have the same lattice
+/// as this one (see `SharesLattice()`) differ only in their tables, so the
+/// lattice cells, hashes, table indices, and spline weights are computed
+/// once per point by the batch kernel and only the table lookups are done
+/// for each generator. The results are the same as calling `generatebatch()`
+/// for each generator, which is what happens for any generator that does not
+/// share the lattice, or for all of them under the conditions in which
+/// `generatebatch()` does not use a batch kernel.
+/// \param x Array of X-coordinates.
+/// \param y Array of Y-coordinates.
+/// \param count Number of points.
+/// \param gen Array of pointers to noise generators.
+/// \param ngen Number of noise generators.
+/// \param result [OUT] Array of `ngen` arrays of `count` noise values in
+/// \f$[-1, 1]\f$, one for each noise generator.
+/// \param t Noise type.
+/// \param n Number of octaves.
+/// \param alpha Lacunarity. Defaults to 0.5f.
+/// \param beta Persistence. Defaults to 2.0f.
+
+void CPerlinNoise2D::generatefused(const double* x, const double* y,
+  size_t count, const CPerlinNoise2D* const* gen, size_t ngen, float** result,
+  eNoise t, size_t n, float alpha, float beta) const
+{
+  const float** pTables = new const float*[ngen]; //tables of fused generators
+  size_t* pIndex = new size_t[ngen]; //indices of fused generators
+  size_t nFused = 0; //number of fused generators
+
+  const bool bFuse = m_pKernel != nullptr && m_eHash == eHash::Permutation &&
+    beta == 2.0f && (t == eNoise::Perlin || t == eNoise::Value) &&
+    n <= MAXFUSEDOCTAVES; //whether the batch kernel can fuse them
+
+  for(size_t k=0; k<ngen; k++)
+    if(bFuse && SharesLattice(*gen[k])){ //fuse it
+      pTables[nFused] = gen[k]->m_fTable;
+      pIndex[nFused++] = k;
+    } //if
+
+    else gen[k]->generatebatch(x, y, count, result[k], t, n, alpha, beta);
+
+  if(nFused > 0){
+    const size_t nChunk = 256; //points per chunk, a multiple of 16
+
+    int32_t nX[nChunk], nY[nChunk]; //masked lattice cells
+    float fX[nChunk], fY[nChunk]; //fractional parts
+    float* sum = new float[nFused*nChunk]; //octave sums for each generator
+
+    KernelArgs args; //kernel arguments
+    InitKernelArgs(args);
+
+    args.eNoiseType = t;
+    args.nOctaves = n;
+    args.fAlpha = alpha;
+    args.pCellX = nX; args.pCellY = nY;
+    args.pFracX = fX; args.pFracY = fY;
+    args.pSum = sum;
+    args.pTables = pTables;
+    args.nTables = nFused;
+
+    float amplitude = 1.0f; //amplitude after the last octave
+    for(size_t i=0; i<n; i++)amplitude *= alpha;
+
+    for(size_t i0=0; i0<count; i0+=nChunk){ //for each chunk
+      const size_t m = std::min<size_t>(nChunk, count - i0); //points in this chunk
+      args.nCount = (m + 15) & ~(size_t)15; //round up to a multiple of 16
+
+      SplitBatch(x + i0, y + i0, m, args.nCount, t, nX, nY, fX, fY);
+      m_pKernel(args); //all fused generators at once
+
+      for(size_t k=0; k<nFused; k++){
+        const float* p = sum + k*args.nCount; //sums for this generator
+        float* r = result[pIndex[k]] + i0; //results for this generator
+
+        for(size_t i=0; i<m; i++)
+          r[i] = normalize(p[i], amplitude, alpha, t);
+      } //for
+    } //for
+
+    delete [] sum;
+  } //if
+
+  delete [] pIndex;
+  delete [] pTables;
+} //generatefused
+
+/// Generate a patch of noise for each of a list of seeds, with all patches
+/// covering the same region and using the same noise settings as this
+/// generator. The patches are dealt out in turn to a pool of threads. Each
+/// thread has a single noise generator of its own, made once, and for each
+/// of its patches it reseeds that generator, which rebuilds the tables in
+/// place without allocating memory, then generates the patch a row at a time
+/// with `generatebatch()`. The cost of setting up a patch is therefore just
+/// the cost of randomizing the tables, which is small compared to the cost
+/// of generating the noise. Each patch is written by exactly one thread, so
+/// no locks are needed, and the result does not depend on the number of
+/// threads. Patch \f$k\f$ is the same as the image that this generator
+/// would produce after `Reseed(seeds[k])`.
+/// \param seeds Array of PRNG seeds.
+/// \param count Number of seeds.
+/// \param r Region covered by each patch.
+/// \param result [OUT] Array of `count` patches, each of which is an array of
+/// `r.nWidth*r.nHeight` noise values in row-major order.
+/// \param t Noise type.
+/// \param n Number of octaves.
+/// \param alpha Lacunarity. Defaults to 0.5f.
+/// \param beta Persistence. Defaults to 2.0f.
+/// \param threads Number of threads, 0 for one per hardware thread.
+/// Defaults to 0.
+
+void CPerlinNoise2D::generatepatches(const UINT* seeds, size_t count,
+  const PatchRegion& r, float* result, eNoise t, size_t n, float alpha,
+  float beta, UINT threads) const
+{
+  if(threads == 0)
+    threads = std::max<UINT>(1U, std::thread::hardware_concurrency());
+  threads = (UINT)std::min<size_t>(threads, count); //no idle threads
+
+  std::vector<std::thread> thread; //worker threads
+
+  for(UINT i=0; i<threads; i++)
+    thread.push_back(std::thread(&CPerlinNoise2D::GetPatches, this, seeds,
+      count, i, threads, std::cref(r), result, t, n, alpha, beta));
+
+  for(std::thread& th: thread)
+    th.join();
+} //generatepatches
+
+/// Generate every \f$m\f$-th patch of noise for `generatepatches()`, starting
+/// at a given patch, using a noise generator with the same settings as this
+/// one.
+/// \param seeds Array of PRNG seeds.
+/// \param count Number of seeds.
+/// \param first First patch.
+/// \param m Distance between patches.
+/// \param r Region covered by each patch.
+/// \param result [OUT] Array of `count` patches.
+/// \param t Noise type.
+/// \param n Number of octaves.
+/// \param alpha Lacunarity.
+/// \param beta Persistence.
+
+void CPerlinNoise2D::GetPatches(const UINT* seeds, size_t count, size_t first,
+  size_t m, const PatchRegion& r, float* result, eNoise t, size_t n,
+  float alpha, float beta) const
+{
+  CPerlinNoise2D perlin; //this thread's noise generator
+  perlin.CopySettings(*this);
+
+  const size_t nSize = r.nWidth*r.nHeight; //number of noise values per patch
+  double* pX = new double[r.nWidth]; //X-coordinates of a row
+  double* pY = new double[r.nWidth]; //Y-coordinates of a row
+
+  for(size_t i=0; i<r.nWidth; i++)
+    pX[i] = r.dX + i/(double)r.fScale;
+
+  for(size_t k=first; k<count; k+=m){ //for each of this thread's patches
+    perlin.Reseed(seeds[k]); //rebuild the tables in place
+
+    for(size_t j=0; j<r.nHeight; j++){ //for each row
+      std::fill(pY, pY + r.nWidth, r.dY + j/(double)r.fScale);
+      perlin.generatebatch(pX, pY, r.nWidth,
+        result + k*nSize + j*r.nWidth, t, n, alpha, beta);
+    } //for
+  } //for
+
+  delete [] pX;
+  delete [] pY;
+} //GetPatches
+
+/// Compute a two-channel warp field at a point, that is, multiple octaves of
+/// Perlin noise for each channel with both channels sharing the corner
+/// hashes in each octave (see `noise2()`). No fractal transform is applied,
+/// since the warp field must be signed.
+/// \param x X-coordinate of a 2D point.
+/// \param y Y-coordinate of a 2D point.
+/// \param n Number of octaves, at least 1.
+/// \param alpha Lacunarity.
+/// \param beta Persistence.
+/// \param dx [OUT] Normalized sum of octaves for the first channel.
+/// \param dy [OUT] Normalized sum of octaves for the second channel.
+
+void CPerlinNoise2D::warp(double x, double y, size_t n, float alpha,
+  float beta, float& dx, float& dy) const
+{
+  assert(n > 0);
+
+  int64_t nX, nY; //integer parts
+  float fX, fY; //fractional parts
+  split(x, y, eNoise::Perlin, nX, nY, fX, fY);
+
+  float sumX = 0.0f, sumY = 0.0f; //for result
+  float amplitude = 1.0f; //octave amplitude
+
+  for(size_t i=0; i<n; i++){ //for each octave
+    float a, b; //octave of each channel
+    noise2(nX, nY, fX, fY, a, b);
+    sumX += amplitude*a; //scale noise by amplitude
+    sumY += amplitude*b; //scale noise by amplitude
+    amplitude *= alpha; //reduce amplitude by lacunarity  
+    scale(nX, fX, beta); scale(nY, fY, beta); //multiply frequency by persistence
+  } //for
+
+  dx = (1 - alpha)*sumX/(1 - amplitude); //sum of geometric progression
+  dy = (1 - alpha)*sumY/(1 - amplitude); //sum of geometric progression
+} //warp
+
+/// Generate domain warped noise at each of a batch of points. Each level of
+/// warping replaces a point \f$p\f$ by \f$p + k g(q)\f$, where \f$q\f$ is
+/// the point given by the previous level (initially \f$p\f$ itself) and
+/// \f$g\f$ is the two-channel Perlin noise warp field computed by `warp()`
+/// with that level's number of octaves. For example, two levels give
+/// \f$f(p + k g(p + k g(p)))\f$, where \f$f\f$ is the noise of type `t`.
+/// Under the same conditions as `generatebatch()`, the points are processed
+/// a chunk at a time, with every level of the warp field and then the final
+/// noise computed by the batch kernel while the chunk is still in cache.
+/// The results are the same either way.
+/// \param x Array of X-coordinates.
+/// \param y Array of Y-coordinates.
+/// \param count Number of points.
+/// \param result [OUT] Array of `count` noise values in \f$[-1, 1]\f$.
+/// \param t Noise type.
+/// \param n Number of octaves.
+/// \param octaves Array of the number of octaves of the warp field at each
+/// level, innermost first. Levels with no octaves are skipped.
+/// \param levels Number of levels of warping.
+/// \param k Warp strength in lattice units.
+/// \param alpha Lacunarity. Defaults to 0.5f.
+/// \param beta Persistence. Defaults to 2.0f.
+
+void CPerlinNoise2D::generatewarp(const double* x, const double* y,
+  size_t count, float* result, eNoise t, size_t n, const size_t* octaves,
+  size_t levels, float k, float alpha, float beta) const
+{
+  if(m_pKernel == nullptr || m_eHash != eHash::Permutation || beta != 2.0f ||
+    t == eNoise::None)
+  {
+    for(size_t i=0; i<count; i++){ //one at a time
+      double u = x[i], v = y[i]; //warped point
+
+      for(size_t j=0; j<levels; j++) //for each level
+        if(octaves[j] > 0){
+          float dx, dy; //warp field
+          warp(u, v, octaves[j], alpha, beta, dx, dy);
+          u = x[i] + k*dx; v = y[i] + k*dy;
+        } //if
+
+      result[i] = generate(u, v, t, n, alpha, beta);
+    } //for
+
+    return;
+  } //if
+
+  const size_t nChunk = 256; //points per chunk, a multiple of 16
+
+  double u[nChunk], v[nChunk]; //warped points
+  int32_t nX[nChunk], nY[nChunk]; //masked lattice cells
+  float fX[nChunk], fY[nChunk]; //fractional parts
+  float sum[nChunk], sum2[nChunk]; //octave sums
+
+  KernelArgs args; //kernel arguments
+  InitKernelArgs(args);
+
+  args.fAlpha = alpha;
+  args.pCellX = nX; args.pCellY = nY;
+  args.pFracX = fX; args.pFracY = fY;
+  args.pSum = sum;
+
+  for(size_t i0=0; i0<count; i0+=nChunk){ //for each chunk
+    const size_t m = std::min<size_t>(nChunk, count - i0); //points in this chunk
+    args.nCount = (m + 15) & ~(size_t)15; //round up to a multiple of 16
+
+    std::copy(x + i0, x + i0 + m, u);
+    std::copy(y + i0, y + i0 + m, v);
+
+    //warp field for each level
+
+    args.eNoiseType = eNoise::Perlin;
+    args.pSum2 = sum2;
+
+    for(size_t j=0; j<levels; j++){ //for each level
+      if(octaves[j] == 0)continue; //skip empty levels
+
+      args.nOctaves = octaves[j];
+      SplitBatch(u, v, m, args.nCount, eNoise::Perlin, nX, nY, fX, fY);
+      m_pKernel(args); //both channels at once
+
+      float amplitude = 1.0f; //amplitude after the last octave
+      for(size_t i=0; i<octaves[j]; i++)amplitude *= alpha;
+
+      for(size_t i=0; i<m; i++){ //warp points
+        const float dx = (1 - alpha)*sum[i]/(1 - amplitude); //as in warp()
+        const float dy = (1 - alpha)*sum2[i]/(1 - amplitude); //as in warp()
+        u[i] = x[i0 + i] + k*dx; v[i] = y[i0 + i] + k*dy;
+      } //for
+    } //for
+
+    //noise at warped points
+
+    args.eNoiseType = t;
+    args.nOctaves = n;
+    args.pSum2 = nullptr;
+
+    SplitBatch(u, v, m, args.nCount, t, nX, nY, fX, fY);
+    m_pKernel(args); //the heavy lifting
+
+    float amplitude = 1.0f; //amplitude after the last octave
+    for(size_t i=0; i<n; i++)amplitude *= alpha;
+
+    for(size_t i=0; i<m; i++)
+      result[i0 + i] = normalize(sum[i], amplitude, alpha, t);
+  } //for
+} //generatewarp
+
+/// Normalize a sum of octaves into \f$[-1, 1]\f$. The octave amplitudes form
+/// a geometric progression, so the largest possible magnitude of the sum is
+/// \f$(1 - \alpha^n)/(1 - \alpha)\f$ for \f$n\f$ octaves and
+/// lacunarity \f$\alpha\f$. Perlin noise is scaled up slightly since it
+/// very rarely gets close to its theoretical extremes. Simplex noise is
+/// already scaled by `simplex()`. Turbulence is left in \f$[0, 1]\f$ and
+/// the ridged multifractal is moved from \f$[0, 1]\f$ to \f$[-1, 1]\f$.
+/// The result is then clamped, in case Perlin noise does get close to its
+/// extremes or rounding error takes any fractal out of range.
+/// \param sum Sum of octaves scaled by their amplitudes.
+/// \param amplitude Amplitude of the octave after the last one, that is,
+/// \f$\alpha^n\f$.
+/// \param alpha Lacunarity.
+/// \param t Noise type.
+/// \return The normalized sum in \f$[-1, 1]\f$, or zero if there are no
+/// octaves.
+
+inline const float CPerlinNoise2D::normalize(float sum, float amplitude,
+  float alpha, eNoise t) const
+{
+  if(amplitude == 1.0f)return 0.0f; //no octaves
 
   float result = (1 - alpha)*sum/(1 - amplitude); //sum of geometric progression
-  if(t == eNoise::Perlin)result *= 4.0f/3.0f; //scale up Perlin noise
+
+  switch(m_eFractal){
+    case eFractal::Sum:
+      if(t == eNoise::Perlin) //scale up Perlin noise
+        result *= 4.0f/3.0f;
+    break;
+
+    case eFractal::Ridged:
+      result = 2.0f*result - 1.0f; //from [0, 1] to [-1, 1]
+    break;
+
+    default: break;
+  } //switch
+
+  result = clamp(-1.0f, result, 1.0f); //in case of rounding
   assert(-1.0f <= result && result <= 1.0f); //safety
   return result;
-} //generate
+} //normalize
 
 #pragma endregion Noise generation functions
 
+////////////////////////////////////////////////////////////////////////////////
+// Fixed-point noise generation functions.
+
+#pragma region Fixed-point noise generation functions
+
+/// Compute a spline function in fixed point. This is the integer equivalent
+/// of `spline()`, with the parameter and result both in Q16, that is,
+/// multiplied by \f$2^{16}\f$. Intermediate products are 64-bit and each is
+/// shifted back down to Q16 as soon as it is formed.
+/// \param t Parameter in Q16 in the range \f$[0, 2^{16}]\f$.
+/// \return The spline of \f$\mathsf{t}\f$ in Q16.
+
+inline const int32_t CPerlinNoise2D::splinefixed(int32_t t) const{
+  assert(0 <= t && t <= 0x10000);
+
+  const int64_t t2 = ((int64_t)t*t) >> 16; //t squared in Q16
+  int64_t result = t; //for the result
+
+  switch(m_eSpline){
+    case eSpline::None: break;
+
+    case eSpline::Cubic: //3t^2 - 2t^3
+      result = (t2*(3*0x10000 - 2*(int64_t)t)) >> 16;
+    break;
+
+    case eSpline::Quintic: //10t^3 - 15t^4 + 6t^5
+      result = (((t2*t) >> 16)*
+        (10*0x10000 + ((3*(int64_t)t*(2*(int64_t)t - 5*0x10000)) >> 16))) >> 16;
+    break;
+  } //switch
+  
+  assert(0 <= result && result <= 0x10000);
+  return (int32_t)result;
+} //splinefixed
+
+/// Fixed-point equivalent of `z()`. For Perlin noise, multiply the Q15
+/// gradients from `m_nTable16` by the Q16 coordinates, giving a Q15 result.
+/// For Value noise, just read the Q15 value directly from the table.
+/// If the table-free hash is being used, then the gradients or values are
+/// computed by `shape()` in floating point and rounded to Q15 instead.
+/// `shape()` calls `logf()` and `sqrtf()` for some distributions and has
+/// polynomials that a compiler may contract into fused multiply-adds, so
+/// fixed-point noise with the table-free hash is not guaranteed to be the
+/// same on every platform.
+/// \param h Hash value for gradient table index.
+/// \param x X-coordinate of point in Q16 in the range \f$[-2^{16}, 2^{16}]\f$.
+/// \param y Y-coordinate of point in Q16 in the range \f$[-2^{16}, 2^{16}]\f$.
+/// \param t Noise type.
+/// \return Corresponding Z-value in Q15.
+
+inline const int32_t CPerlinNoise2D::zfixed(size_t h, int32_t x, int32_t y,
+  eNoise t) const
+{
+  if(m_eHash == eHash::Stateless){
+    const int64_t g0 = lroundf(32767.0f*shape(h >> 16)); //first in Q15
+    const int64_t g1 = lroundf(32767.0f*shape(h)); //second in Q15
+
+    switch(t){ //noise type
+      case eNoise::Perlin: return (int32_t)((x*g0 + y*g1) >> 16);
+      case eNoise::Value:  return (int32_t)g0;
+      default: return 0;
+    } //switch
+  } //if
+
+  assert(h == (h & m_nMask)); 
+
+  switch(t){ //noise type
+    case eNoise::Perlin: //gradient times position
+      return (int32_t)(((int64_t)x*m_nTable16[h & m_nTableMask] +
+        (int64_t)y*m_nTable16[hash(h) & m_nTableMask]) >> 16);
+      
+    case eNoise::Value: //get value directly from table
+      return m_nTable16[h & m_nTableMask];
+
+    default: return 0;
+  } //switch
+} //zfixed
+
+/// Compute a single octave of Perlin or Value noise at a 2D point using only
+/// integer arithmetic. This follows `noise()` step for step, using the same
+/// corner hashes, so the result differs from it only by rounding.
+/// \param x X-coordinate of point in Q16.
+/// \param y Y-coordinate of point in Q16.
+/// \param t Noise type.
+/// \return A smoothed noise value in Q15.
+
+const int32_t CPerlinNoise2D::noisefixed(int64_t x, int64_t y, eNoise t) const{
+  const int64_t nX = x >> 16; //integer part of x, rounded down
+  const int64_t nY = y >> 16; //integer part of y, rounded down
+
+  const int32_t fX = (int32_t)(x & 0xFFFF); //fractional part of x in Q16
+  const int32_t fY = (int32_t)(y & 0xFFFF); //fractional part of y in Q16
+
+  const int64_t sX = splinefixed(fX); //smoothed fractional part of x
+  const int64_t sY = splinefixed(fY); //smoothed fractional part of y
+
+  size_t c[4] = {0}; //for hashed values at corners
+  HashCorners((size_t)nX, (size_t)nY, c); //get hashed values at corners
+
+  //lerp along the top and bottom along the X-axis
+
+  const int64_t z0 = zfixed(c[0], fX,           fY,           t);
+  const int64_t z1 = zfixed(c[1], fX - 0x10000, fY,           t);
+  const int64_t z2 = zfixed(c[2], fX,           fY - 0x10000, t);
+  const int64_t z3 = zfixed(c[3], fX - 0x10000, fY - 0x10000, t);
+
+  const int64_t a = z0 + ((sX*(z1 - z0)) >> 16);
+  const int64_t b = z2 + ((sX*(z3 - z2)) >> 16);
+
+  //now lerp these values along the Y-axis
+
+  return (int32_t)(a + ((sY*(b - a)) >> 16));
+} //noisefixed
+
+/// Fixed-point equivalent of `fractal()`.
+/// \param n Noise value in Q15.
+/// \param weight [IN, OUT] Ridged multifractal weight in Q15.
+/// \return Transformed noise value in Q15.
+
+inline const int32_t CPerlinNoise2D::fractalfixed(int32_t n, int32_t& weight)
+  const
+{
+  switch(m_eFractal){
+    case eFractal::Turbulence: return abs(n);
+    case eFractal::Billow:     return 2*abs(n) - 0x8000;
+
+    case eFractal::Ridged: {
+      int32_t s = 0x8000 - abs(n); //invert so that ridges are high
+      s = (s*s) >> 15; //sharpen ridges
+      s = (s*weight) >> 15; //weight by previous octave
+      weight = std::min<int32_t>(2*s, 0x8000);
+      return s;
+    } //case
+
+    default: return n;
+  } //switch
+} //fractalfixed
+
+/// Fixed-point equivalent of `generate()`. Coordinates are in Q16, that is,
+/// 48 bits of integer part and 16 bits of fraction, and the result is in Q15.
+/// Everything is done with integer adds, multiplies, and shifts, so the result
+/// depends only on the seed, the noise settings, and `m_nTable16`, and not on
+/// the compiler, floating point model, or vector width, which makes it
+/// suitable for lockstep simulations. See `QuantizeTable()` for which tables
+/// are themselves platform-independent. The table-free hash is excluded,
+/// since its gradients are computed in floating point (see `zfixed()`). The
+/// persistence is fixed at 2 because that is what lets each octave scale the
+/// coordinates exactly with a shift, so the coordinates must be less than
+/// \f$2^{63 - n}\f$ in magnitude for \f$n\f$ octaves, or else they would
+/// overflow.
+/// Simplex and Worley noise are not supported. There is no 16-bit SIMD
+/// version: the gradient and interpolation products in `zfixed()` and
+/// `noisefixed()` need more than 32 bits, and truncating them to fit into
+/// 16-bit lanes would change the results.
+/// \param x X-coordinate of a 2D point in Q16, less than \f$2^{63 - n}\f$ in
+/// magnitude.
+/// \param y Y-coordinate of a 2D point in Q16, less than \f$2^{63 - n}\f$ in
+/// magnitude.
+/// \param t Noise type.
+/// \param n Number of octaves.
+/// \param alpha Lacunarity in Q16. Defaults to 0.5 (that is, 0x8000).
+/// \return Smooth noise in Q15, that is, in \f$[-2^{15}, 2^{15}]\f$.
+
+const int32_t CPerlinNoise2D::generatefixed(int64_t x, int64_t y, eNoise t,
+  size_t n, int32_t alpha) const
+{
+  assert(0 <= alpha && alpha < 0x10000);
+
+  if(n == 0)return 0; //no octaves
+
+  const int64_t limit = (n < 63)? (int64_t)1 << (63 - n): 0; //coordinate limit
+  assert(-limit < x && x < limit && -limit < y && y < limit); //no overflow
+
+  int64_t sum = 0; //for result in Q15
+  int64_t amplitude = 0x10000; //octave amplitude in Q16
+  int32_t weight = 0x8000; //ridged multifractal weight in Q15
+
+  for(size_t i=0; i<n; i++){ //for each octave
+    const int32_t v = fractalfixed(noisefixed(x, y, t), weight); //octave
+    sum += (amplitude*v) >> 16; //scale noise by amplitude
+    amplitude = (amplitude*alpha) >> 16; //reduce amplitude by lacunarity  
+    x *= 2; y *= 2; //double frequency
+  } //for
+
+  int64_t result = (0x10000 - alpha)*sum/(0x10000 - amplitude); //normalize
+
+  switch(m_eFractal){
+    case eFractal::Sum:
+      if(t == eNoise::Perlin)result = 4*result/3; //scale up Perlin noise
+    break;
+
+    case eFractal::Ridged:
+      result = 2*result - 0x8000; //from [0, 1] to [-1, 1]
+    break;
+
+    default: break;
+  } //switch
+
+  return (int32_t)std::max<int64_t>(-0x8000, std::min<int64_t>(result, 0x8000));
+} //generatefixed
+
+#pragma endregion Fixed-point noise generation functions
+
 ////////////////////////////////////////////////////////////////////////////////
 // Reader functions.
 
@@ -624,4 +2185,39 @@ const eDistribution CPerlinNoise2D::GetDistribution() const{
   return m_eDistribution;
 } //GetDistribution
 
+/// Reader function for the instruction set used by the batch kernels.
+/// \return The instruction set.
+
+const eISA CPerlinNoise2D::GetISA() const{
+  return m_eISA;
+} //GetISA
+
+/// Reader function for the animation time.
+/// \return The animation time.
+
+const double CPerlinNoise2D::GetTime() const{
+  return m_dTime;
+} //GetTime
+
+/// Reader function for the pseudo-random number generator seed.
+/// \return The seed.
+
+const UINT CPerlinNoise2D::GetSeed() const{
+  return m_nSeed;
+} //GetSeed
+
+/// Reader function for the distance used for Worley noise.
+/// \return The Worley noise distance.
+
+const eWorley CPerlinNoise2D::GetWorley() const{
+  return m_eWorley;
+} //GetWorley
+
+/// Reader function for the way that octaves are combined.
+/// \return The fractal type.
+
+const eFractal CPerlinNoise2D::GetFractal() const{
+  return m_eFractal;
+} //GetFractal
+
 #pragma endregion Reader functions
@@ -27,42 +27,100 @@
 #ifndef __PERLIN_H__
 #define __PERLIN_H__
 
-#include <windows.h>
-#include <windowsx.h>
-#include <random>
+#ifdef _WIN32
+  #include <windows.h>
+  #include <windowsx.h>
+#else
+  typedef unsigned int UINT; ///< Unsigned integer, as in `windows.h`.
+#endif
+
+#include <cstdint>
 
 #include "Defines.h"
+#include "Kernels.h"
 
-/// \brief 2D Perlin and Value noise generator.
+/// \brief Region covered by a patch of noise.
+///
+/// A rectangle of pixels whose top-left pixel is at a given point, with a
+/// given number of pixels per unit of noise, as used by
+/// `CPerlinNoise2D::generatepatches()`.
+
+struct PatchRegion{
+  double dX = 0.0; ///< X-coordinate of the top-left pixel.
+  double dY = 0.0; ///< Y-coordinate of the top-left pixel.
+  float fScale = 64.0f; ///< Number of pixels per unit.
+  size_t nWidth = 256; ///< Width in pixels.
+  size_t nHeight = 256; ///< Height in pixels.
+}; //PatchRegion
+
+/// \brief 2D Perlin, Value, Simplex, and Worley noise generator.
 ///
 /// This implementation of a Perlin noise generator can generate either Perlin
-/// or Value noise using gradients or values (respectively) from a table
-/// that can be filled with pseudo-random numbers from various probability
-/// distributions. There is a choice of hash functions including Perlin's
-/// original pseudo-random permutation method and various non-repeating
-/// hash functions. There is a choice of spline functions including cubic and
-/// quintic splines. The table size can be doubled or halved within
-/// hard-coded limits. The source of pseudo-randomness is
-/// `std::default_random_engine`
+/// or Value noise using gradients or values (respectively) from a table that
+/// can be filled with pseudo-random numbers from various probability
+/// distributions. Simplex noise uses the same gradients on a triangular grid,
+/// and Worley noise uses them to jitter a feature point in each cell. Any of
+/// these can be domain warped by a two-channel Perlin noise field, and animated
+/// by rotating the table entries over time. There is a choice of hash functions
+/// including Perlin's original pseudo-random permutation method and various
+/// non-repeating hash functions, one of which needs no tables at all. There is
+/// a choice of spline functions including cubic and quintic splines. The table
+/// size can be doubled or halved within hard-coded limits. Large tables are
+/// made from small ones so that lookups stay in cache. The source of
+/// pseudo-randomness is a counter-based generator, so the tables come out the
+/// same on every platform except where a distribution needs the C runtime's
+/// transcendental functions. Batches of points can be computed using SIMD
+/// kernels for the best instruction set that the processor supports, which is
+/// chosen at run time, and patches of noise for many seeds can be generated at
+/// once on a pool of threads.
 
 class CPerlinNoise2D{
   private:
     eHash m_eHash = eHash::Permutation; ///< Hash function type.
     eSpline m_eSpline = eSpline::Cubic; ///< Spline function type.
     eDistribution m_eDistribution = eDistribution::Uniform; ///< Uniform distribution..
-
-    size_t* m_nPerm = nullptr; ///< Random permutation, used for hash function.
+    eWorley m_eWorley = eWorley::F1; ///< Worley noise distance.
+    eFractal m_eFractal = eFractal::Sum; ///< Octave combination.
+
+    uint32_t* m_nPerm = nullptr; ///< Random permutation, used for hash function.
+    uint32_t* m_nPermLo = nullptr; ///< Permutation of low bits, points into `m_nPerm`.
+    uint32_t* m_nPermHi = nullptr; ///< Permutation of high bits, points into `m_nPerm`.
+    uint32_t* m_nKeyLo = nullptr; ///< Keys indexed by low bits, points into `m_nPerm`.
+    uint32_t* m_nKeyHi = nullptr; ///< Keys indexed by high bits, points into `m_nPerm`.
+
+    uint32_t m_nPerm251[251]; ///< Random permutation of size 251.
+    uint32_t m_nPerm256[256]; ///< Random permutation of size 256.
+    uint32_t m_nPerm257[257]; ///< Random permutation of size 257.
     float* m_fTable = nullptr; ///< Table of gradients or values.
+    float* m_fTable0 = nullptr; ///< Table of gradients or values at time zero.
+    int16_t* m_nTable16 = nullptr; ///< Table of gradients or values in Q15.
     
-    std::default_random_engine m_stdRandom; ///< PRNG.
     UINT m_nSeed = 0; ///< PRNG seed.
+    const size_t m_nPermStream = 1; ///< PRNG stream for the permutation.
+    const size_t m_nTableStream = 2; ///< PRNG stream for the gradient/value table.
+    const size_t m_nPermHiStream = 3; ///< PRNG stream for the high bit permutation.
+    const size_t m_nKeyStream = 4; ///< PRNG stream for the permutation keys.
+    const size_t m_nCoprimeStream = 5; ///< First of three PRNG streams for coprime permutations.
+    const size_t m_nPhaseStream = 8; ///< PRNG stream for animation phases.
+    const size_t m_nSpeedStream = 9; ///< PRNG stream for animation speeds.
+
+    double m_dTime = 0.0; ///< Animation time.
 
     const size_t m_nDefTableSize = 256; ///< Default table size.
     const size_t m_nMinTableSize = 16; ///< Min table size.
-    const size_t m_nMaxTableSize = 1024; ///< Max table size.
+    const size_t m_nMaxTableSize = 1 << 20; ///< Max table size.
+    const size_t m_nBlockSize = 1024; ///< Max size of each small table, a power of 2.
+    const size_t m_nBlockBits = 10; ///< Log base 2 of `m_nBlockSize`.
 
     size_t m_nSize = m_nDefTableSize; ///< Table size, must be a power of 2.
     size_t m_nMask = m_nDefTableSize - 1; ///< Mask for values less than `m_nSize`.
+    size_t m_nTableSize = m_nDefTableSize; ///< Gradient/value table size.
+    size_t m_nTableMask = m_nDefTableSize - 1; ///< Mask for values less than `m_nTableSize`.
+    size_t m_nHiMask = 0; ///< Mask for the high bits of a two-level permutation.
+
+    eISA m_eISA = eISA::Scalar; ///< Instruction set for batch kernels.
+    NoiseKernel m_pKernel = nullptr; ///< Batch kernel, nullptr for scalar.
+    static const NoiseKernel m_pKernelTable[]; ///< Batch kernel for each instruction set.
     
     inline const size_t pair(size_t, size_t) const; ///< Perlin pairing function.
     inline const size_t pairstd(size_t, size_t) const; ///< Std pairing function.
@@ -70,8 +128,15 @@ class CPerlinNoise2D{
     inline const size_t hash(size_t) const; ///< Perlin hash function.
     inline const size_t hashstd(size_t) const; ///< std::hash function.
     inline const size_t hash2(size_t, size_t) const; ///< Hash function.
+    inline const size_t hashfree(size_t, size_t) const; ///< Table-free hash function.
+    inline const size_t hashcoprime(size_t, size_t) const; ///< Coprime permutation hash function.
 
     void HashCorners(size_t, size_t, size_t[4]) const; ///< Hash grid corners.
+    inline const size_t hashpoint(size_t, size_t) const; ///< Hash a grid point.
+    inline const size_t rekey(size_t) const; ///< Hash for the second warp channel.
+
+    inline const uint64_t random(size_t, size_t) const; ///< Counter-based PRNG.
+    inline const float uniform(size_t, size_t) const; ///< Uniform PRNG in [0, 1).
     
     void RandomizeTableUniform(); ///< Randomize table using uniform distribution.
     void RandomizeTableCos(); ///< Randomize table using cosine.
@@ -81,14 +146,42 @@ class CPerlinNoise2D{
 
     void RandomizeTableMidpoint(size_t, size_t, float); ///< Midpoint displacement.
     void RandomizeTableMidpoint(); ///< Randomize table using midpoint displacement.
+    void QuantizeTable(); ///< Copy table to Q15 fixed point.
+    void AnimateTable(); ///< Rotate table entries to the current time.
 
     inline const float spline(float) const; ///< Spline curve.
+    inline const float shape(size_t) const; ///< Shape hash bits to distribution.
+    inline const float zfree(size_t, float, float, eNoise) const; ///< Apply table-free gradients.
     inline const float z(size_t, float, float, eNoise) const; ///< Apply gradients.
     const float Lerp(float, float, float, size_t*, eNoise) const; ///< Linear interpolation.
-    const float noise(float, float, eNoise) const; ///< Perlin noise.
-
+    const float noise(int64_t, int64_t, float, float, eNoise) const; ///< Perlin noise.
+    void noise2(int64_t, int64_t, float, float, float&, float&) const; ///< Two channels of Perlin noise.
+    const float simplex(int64_t, int64_t, float, float) const; ///< Simplex noise.
+    inline void feature(size_t, float&, float&) const; ///< Feature point offset.
+    const float worley(int64_t, int64_t, float, float) const; ///< Worley noise.
+    inline void split(double, double, eNoise, int64_t&, int64_t&, float&,
+      float&) const; ///< Split point into lattice cell and fraction.
+    inline void scale(int64_t&, float&, float) const; ///< Scale lattice coordinate.
+    inline const float fractal(float, float&) const; ///< Transform an octave.
+    inline const float normalize(float, float, float, eNoise) const; ///< Normalize octave sum.
+    void warp(double, double, size_t, float, float, float&, float&) const; ///< Warp field.
+
+    void InitKernelArgs(KernelArgs&) const; ///< Set kernel table arguments.
+    void SplitBatch(const double*, const double*, size_t, size_t, eNoise,
+      int32_t*, int32_t*, float*, float*) const; ///< Split a chunk of points.
+    const bool SharesLattice(const CPerlinNoise2D&) const; ///< Check for same lattice.
+    void GetPatches(const UINT*, size_t, size_t, size_t, const PatchRegion&,
+      float*, eNoise, size_t, float, float) const; ///< Get every m-th patch.
+
+    inline const int32_t splinefixed(int32_t) const; ///< Fixed-point spline curve.
+    inline const int32_t zfixed(size_t, int32_t, int32_t, eNoise) const; ///< Apply fixed-point gradients.
+    const int32_t noisefixed(int64_t, int64_t, eNoise) const; ///< Fixed-point Perlin noise.
+    inline const int32_t fractalfixed(int32_t, int32_t&) const; ///< Fixed-point octave transform.
+
+    void Shuffle(uint32_t*, size_t, size_t); ///< Randomize part of the permutation.
     void RandomizePermutation(); ///< Randomize permutation.
     void Initialize(); ///< Initialize.
+    void CopySettings(const CPerlinNoise2D&); ///< Copy settings but not seed.
 
   public:
     CPerlinNoise2D(); ///< Constructor.
@@ -96,10 +189,29 @@ class CPerlinNoise2D{
     
     const float generate(float, float, eNoise, size_t, float=0.5f, float=2.0f)
       const; ///< Generate noise at a point.
+    const float generate(double, double, eNoise, size_t, float=0.5f, float=2.0f)
+      const; ///< Generate noise at a point far from the origin.
+    const float generate(double, double, float, eNoise, size_t, float=0.5f,
+      float=2.0f) const; ///< Generate band-limited noise at a point.
+    void generatepyramid(float**, size_t, size_t, size_t, double, double, float,
+      eNoise, size_t, float=0.5f, float=2.0f) const; ///< Generate a mip chain.
+    const int32_t generatefixed(int64_t, int64_t, eNoise, size_t, int32_t=0x8000)
+      const; ///< Generate noise at a point using fixed-point arithmetic.
+    void generatebatch(const double*, const double*, size_t, float*, eNoise,
+      size_t, float=0.5f, float=2.0f) const; ///< Generate noise at many points.
+    void generatefused(const double*, const double*, size_t,
+      const CPerlinNoise2D* const*, size_t, float**, eNoise, size_t, float=0.5f,
+      float=2.0f) const; ///< Generate noise at many points for many generators.
+    void generatepatches(const UINT*, size_t, const PatchRegion&, float*, eNoise,
+      size_t, float=0.5f, float=2.0f, UINT=0) const; ///< Generate a patch for each seed.
+    void generatewarp(const double*, const double*, size_t, float*, eNoise,
+      size_t, const size_t*, size_t, float, float=0.5f, float=2.0f)
+      const; ///< Generate domain warped noise at many points.
 
     //functions that change the noise properties
     
     void SetSeed(); ///< Set seed for PRNG.
+    void Reseed(UINT); ///< Set a fixed seed and randomize tables.
     void RandomizeTable(eDistribution); ///< Randomize table from distribution.
 
     bool DoubleTableSize(); ///< Double table size.
@@ -108,6 +220,10 @@ class CPerlinNoise2D{
     
     void SetSpline(eSpline); ///< Set spline function.
     void SetHash(eHash); ///< Set hash function.
+    void SetWorley(eWorley); ///< Set Worley noise distance.
+    void SetFractal(eFractal); ///< Set octave combination.
+    bool SetISA(eISA); ///< Set instruction set for batch kernels.
+    void SetTime(double); ///< Set animation time.
 
     //reader functions
     
@@ -119,6 +235,11 @@ class CPerlinNoise2D{
     const eHash GetHash() const; ///< Get hash function type.
     const eSpline GetSpline() const; ///< Get spline function type.
     const eDistribution GetDistribution() const; ///< Get distribution type.
+    const eWorley GetWorley() const; ///< Get Worley noise distance.
+    const eFractal GetFractal() const; ///< Get octave combination.
+    const eISA GetISA() const; ///< Get instruction set for batch kernels.
+    const double GetTime() const; ///< Get animation time.
+    const UINT GetSeed() const; ///< Get PRNG seed.
 }; //CPerlinNoise2D
 
 #endif //__PERLIN_H__